@@ -9,9 +9,13 @@ win32* {
 }
 
 HEADERS += \
+    $$PWD/include/DS_Atomic.h \
     $$PWD/include/DS_Client.h \
     $$PWD/include/DS_Config.h \
+    $$PWD/include/DS_Context.h \
     $$PWD/include/DS_Events.h \
+    $$PWD/include/DS_Histogram.h \
+    $$PWD/include/DS_LossTracker.h \
     $$PWD/include/DS_Joysticks.h \
     $$PWD/include/DS_Types.h \
     $$PWD/include/DS_Utils.h \
@@ -31,7 +35,10 @@ SOURCES += \
     $$PWD/src/protocols/frc_2020.c \
     $$PWD/src/client.c \
     $$PWD/src/config.c \
+    $$PWD/src/context.c \
     $$PWD/src/events.c \
+    $$PWD/src/histogram.c \
+    $$PWD/src/losstracker.c \
     $$PWD/src/init.c \
     $$PWD/src/joysticks.c \
     $$PWD/src/protocols.c \
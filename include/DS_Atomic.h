@@ -0,0 +1,187 @@
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef _LIB_DS_ATOMIC_H
+#define _LIB_DS_ATOMIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Atomic load (acquire) and store (release) operations, used to share data
+ * between two threads without locks. GCC and Clang use their builtins, MSVC
+ * relies on the ordering guarantees of x86/x64 and a compiler barrier.
+ */
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#   define DS_INLINE __inline
+#else
+#   define DS_INLINE inline
+#endif
+
+/**
+ * Returns the value of \a ptr, memory operations after this load cannot be
+ * moved before it (acquire semantics)
+ */
+static DS_INLINE unsigned int DS_AtomicLoad(const unsigned int *ptr)
+{
+#if defined(_MSC_VER)
+   unsigned int value = *(const volatile unsigned int *)ptr;
+   _ReadWriteBarrier();
+   return value;
+#else
+   return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * Sets the value of \a ptr, memory operations before this store cannot be
+ * moved after it (release semantics)
+ */
+static DS_INLINE void DS_AtomicStore(unsigned int *ptr, const unsigned int value)
+{
+#if defined(_MSC_VER)
+   _ReadWriteBarrier();
+   *(volatile unsigned int *)ptr = value;
+#else
+   __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+/**
+ * Returns the pointer stored in \a ptr (acquire semantics)
+ */
+static DS_INLINE void *DS_AtomicLoadPtr(void *const *ptr)
+{
+#if defined(_MSC_VER)
+   void *value = *(void *const volatile *)ptr;
+   _ReadWriteBarrier();
+   return value;
+#else
+   return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * Stores the given pointer in \a ptr (release semantics)
+ */
+static DS_INLINE void DS_AtomicStorePtr(void **ptr, void *value)
+{
+#if defined(_MSC_VER)
+   _ReadWriteBarrier();
+   *(void *volatile *)ptr = value;
+#else
+   __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+/**
+ * Returns the 64-bit value of \a ptr without tearing, even on 32-bit
+ * systems (acquire semantics)
+ */
+static DS_INLINE uint64_t DS_AtomicLoad64(const uint64_t *ptr)
+{
+#if defined(_MSC_VER) && defined(_M_IX86)
+   return (uint64_t)_InterlockedCompareExchange64((volatile __int64 *)ptr, 0, 0);
+#elif defined(_MSC_VER)
+   uint64_t value = *(const volatile uint64_t *)ptr;
+   _ReadWriteBarrier();
+   return value;
+#else
+   return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * Sets the 64-bit value of \a ptr without tearing, even on 32-bit systems
+ * (release semantics)
+ */
+static DS_INLINE void DS_AtomicStore64(uint64_t *ptr, const uint64_t value)
+{
+#if defined(_MSC_VER) && defined(_M_IX86)
+   __int64 old = *(volatile __int64 *)ptr;
+   __int64 seen;
+   while ((seen = _InterlockedCompareExchange64((volatile __int64 *)ptr, (__int64)value, old)) != old)
+      old = seen;
+#elif defined(_MSC_VER)
+   _ReadWriteBarrier();
+   *(volatile uint64_t *)ptr = value;
+#else
+   __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+/**
+ * Adds the given \a value to \a ptr and returns its previous value (full
+ * barrier)
+ */
+static DS_INLINE unsigned int DS_AtomicFetchAdd(unsigned int *ptr, const unsigned int value)
+{
+#if defined(_MSC_VER)
+   return (unsigned int)_InterlockedExchangeAdd((volatile long *)ptr, (long)value);
+#else
+   return __atomic_fetch_add(ptr, value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+/**
+ * Sets \a ptr to \a desired if it is equal to \a expected (full barrier).
+ * Otherwise, the current value of \a ptr is written to \a expected.
+ *
+ * \returns \c 1 if the value was replaced
+ */
+static DS_INLINE int DS_AtomicCompareExchange(unsigned int *ptr, unsigned int *expected, const unsigned int desired)
+{
+#if defined(_MSC_VER)
+   long seen = _InterlockedCompareExchange((volatile long *)ptr, (long)desired, (long)*expected);
+   if ((unsigned int)seen == *expected)
+      return 1;
+
+   *expected = (unsigned int)seen;
+   return 0;
+#else
+   return __atomic_compare_exchange_n(ptr, expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * Full memory barrier, no memory operation can be moved across it
+ */
+static DS_INLINE void DS_AtomicFence(void)
+{
+#if defined(_MSC_VER)
+   volatile long barrier = 0;
+   _InterlockedExchange(&barrier, 1);
+#else
+   __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
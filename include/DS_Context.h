@@ -0,0 +1,145 @@
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef _LIB_DS_CONTEXT_H
+#define _LIB_DS_CONTEXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "DS_Types.h"
+#include "DS_Events.h"
+#include "DS_Protocol.h"
+
+/**
+ * Holds the state of an independent driver station (its robot state, event
+ * queue, joysticks and protocol). The functions of the LibDS operate on the
+ * current context of the calling thread, which is the default context unless
+ * \c DS_SetCurrentContext() is used.
+ */
+typedef struct _ds_context DS_Context;
+
+/**
+ * The modules that keep their state in a context
+ */
+typedef enum
+{
+   DS_MODULE_CONFIG,
+   DS_MODULE_CLIENT,
+   DS_MODULE_EVENTS,
+   DS_MODULE_JOYSTICKS,
+   DS_MODULE_PROTOCOLS,
+   DS_MODULE_COUNT,
+} DS_ContextModule;
+
+/* Module functions */
+extern void Contexts_Init(void);
+extern void Contexts_Close(void);
+extern void *DS_GetContextData(const DS_ContextModule module);
+extern void DS_SetContextData(const DS_ContextModule module, void *data);
+
+/* Context management */
+extern DS_Context *DS_CreateContext(void);
+extern void DS_DestroyContext(DS_Context *context);
+extern DS_Context *DS_DefaultContext(void);
+extern DS_Context *DS_CurrentContext(void);
+extern DS_Context *DS_SetCurrentContext(DS_Context *context);
+
+/* Client functions */
+extern char *DS_ContextGetCustomFMSAddress(DS_Context *context);
+extern char *DS_ContextGetCustomRadioAddress(DS_Context *context);
+extern char *DS_ContextGetCustomRobotAddress(DS_Context *context);
+extern char *DS_ContextGetDefaultFMSAddress(DS_Context *context);
+extern char *DS_ContextGetDefaultRadioAddress(DS_Context *context);
+extern char *DS_ContextGetDefaultRobotAddress(DS_Context *context);
+extern char *DS_ContextGetAppliedFMSAddress(DS_Context *context);
+extern char *DS_ContextGetAppliedRadioAddress(DS_Context *context);
+extern char *DS_ContextGetAppliedRobotAddress(DS_Context *context);
+extern char *DS_ContextGetGameData(DS_Context *context);
+extern char *DS_ContextGetStatusString(DS_Context *context);
+extern int DS_ContextGetTeamNumber(DS_Context *context);
+extern int DS_ContextGetRobotCode(DS_Context *context);
+extern int DS_ContextGetCanBeEnabled(DS_Context *context);
+extern int DS_ContextGetRobotEnabled(DS_Context *context);
+extern int DS_ContextGetRobotCPUUsage(DS_Context *context);
+extern int DS_ContextGetRobotRAMUsage(DS_Context *context);
+extern int DS_ContextGetRobotDiskUsage(DS_Context *context);
+extern float DS_ContextGetRobotVoltage(DS_Context *context);
+extern DS_Alliance DS_ContextGetAlliance(DS_Context *context);
+extern DS_Position DS_ContextGetPosition(DS_Context *context);
+extern int DS_ContextGetEmergencyStopped(DS_Context *context);
+extern int DS_ContextGetFMSCommunications(DS_Context *context);
+extern int DS_ContextGetRadioCommunications(DS_Context *context);
+extern int DS_ContextGetRobotCommunications(DS_Context *context);
+extern int DS_ContextGetRobotCANUtilization(DS_Context *context);
+extern DS_ControlMode DS_ContextGetControlMode(DS_Context *context);
+extern float DS_ContextGetMaximumBatteryVoltage(DS_Context *context);
+extern void DS_ContextRebootRobot(DS_Context *context);
+extern void DS_ContextRestartRobotCode(DS_Context *context);
+extern void DS_ContextSetGameData(DS_Context *context, const char *data);
+extern void DS_ContextSetTeamNumber(DS_Context *context, const int team);
+extern void DS_ContextSetRobotEnabled(DS_Context *context, const int enabled);
+extern void DS_ContextSetEmergencyStopped(DS_Context *context, const int stop);
+extern void DS_ContextSetAlliance(DS_Context *context, const DS_Alliance alliance);
+extern void DS_ContextSetPosition(DS_Context *context, const DS_Position position);
+extern void DS_ContextSetControlMode(DS_Context *context, const DS_ControlMode mode);
+extern void DS_ContextSetCustomFMSAddress(DS_Context *context, const char *address);
+extern void DS_ContextSetCustomRadioAddress(DS_Context *context, const char *address);
+extern void DS_ContextSetCustomRobotAddress(DS_Context *context, const char *address);
+extern void DS_ContextSendNetConsoleMessage(DS_Context *context, const char *message);
+
+/* Event functions */
+extern int DS_ContextPollEvent(DS_Context *context, DS_Event *event);
+extern int DS_ContextWaitEvent(DS_Context *context, DS_Event *event, const int timeout);
+extern int DS_ContextGetEventFd(DS_Context *context);
+extern void DS_ContextGetEventStatistics(DS_Context *context, DS_EventStatistics *stats);
+
+/* Joystick functions */
+extern int DS_ContextGetJoystickCount(DS_Context *context);
+extern int DS_ContextGetJoystickNumHats(DS_Context *context, int joystick);
+extern int DS_ContextGetJoystickNumAxes(DS_Context *context, int joystick);
+extern int DS_ContextGetJoystickNumButtons(DS_Context *context, int joystick);
+extern int DS_ContextGetJoystickHat(DS_Context *context, int joystick, int hat);
+extern float DS_ContextGetJoystickAxis(DS_Context *context, int joystick, int axis);
+extern int DS_ContextGetJoystickButton(DS_Context *context, int joystick, int button);
+extern void DS_ContextJoysticksReset(DS_Context *context);
+extern void DS_ContextJoysticksAdd(DS_Context *context, const int axes, const int hats, const int buttons);
+extern void DS_ContextSetJoystickHat(DS_Context *context, int joystick, int hat, int angle);
+extern void DS_ContextSetJoystickAxis(DS_Context *context, int joystick, int axis, float value);
+extern void DS_ContextSetJoystickButton(DS_Context *context, int joystick, int button, int pressed);
+
+/* Protocol functions */
+extern void DS_ContextConfigureProtocol(DS_Context *context, const DS_Protocol *ptr);
+extern int DS_ContextSetRealtimeOptions(DS_Context *context, const DS_RealtimeOptions *options);
+extern void DS_ContextGetStatistics(DS_Context *context, DS_Statistics *stats);
+extern void DS_ContextGetSendStatistics(DS_Context *context, const DS_Link link, DS_SendStatistics *stats);
+extern void DS_ContextGetRobotTripTime(DS_Context *context, DS_TripTimeStatistics *stats);
+extern void DS_ContextGetLossStatistics(DS_Context *context, const DS_Link link, DS_LossStatistics *stats);
+extern void DS_ContextGetReceiveLatency(DS_Context *context, const DS_Link link, DS_LatencyStatistics *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef _LIB_DS_HISTOGRAM_H
+#define _LIB_DS_HISTOGRAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * Number of bits used to represent the values inside each power of two,
+ * the buckets are (at most) 1 / 2^(bits - 1) of their values wide, and the
+ * reported values are the middle of a bucket, so the relative error is at
+ * most 1 / 2^bits (under 1% with 7 bits)
+ */
+#define DS_HISTOGRAM_SUB_BITS 7
+
+/**
+ * Number of bits of the largest value that can be recorded (larger values are
+ * recorded as the largest value), with nanoseconds this is about 18 minutes
+ */
+#define DS_HISTOGRAM_MAX_BITS 40
+
+/**
+ * Number of buckets used by each histogram
+ */
+#define DS_HISTOGRAM_BUCKETS ((1 << DS_HISTOGRAM_SUB_BITS) \
+   + (DS_HISTOGRAM_MAX_BITS - DS_HISTOGRAM_SUB_BITS) * (1 << (DS_HISTOGRAM_SUB_BITS - 1)))
+
+/**
+ * Log-linear (HDR-style) histogram with a fixed size, values are counted in
+ * buckets whose width grows with the value, so that every value is recorded
+ * with the same relative precision
+ */
+typedef struct _histogram
+{
+   uint64_t count; /**< Number of recorded values */
+   uint64_t min; /**< Smallest recorded value */
+   uint64_t max; /**< Largest recorded value */
+   uint64_t total; /**< Sum of the recorded values */
+   uint32_t buckets[DS_HISTOGRAM_BUCKETS]; /**< Number of values in each bucket */
+} DS_Histogram;
+
+extern void DS_HistogramReset(DS_Histogram *histogram);
+extern void DS_HistogramRecord(DS_Histogram *histogram, uint64_t value);
+extern uint64_t DS_HistogramMean(const DS_Histogram *histogram);
+extern uint64_t DS_HistogramPercentile(const DS_Histogram *histogram, const double percentile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
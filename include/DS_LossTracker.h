@@ -0,0 +1,84 @@
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef _LIB_DS_LOSS_TRACKER_H
+#define _LIB_DS_LOSS_TRACKER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * Number of seconds of history used to calculate the loss percentage
+ */
+#define DS_LOSS_PERIODS 60
+
+/**
+ * Sequence jumps larger than this value are not counted as losses (or late
+ * packets), instead the tracker assumes that the sender was restarted
+ */
+#define DS_LOSS_RESYNC 1024
+
+/**
+ * Classification of a received sequence number
+ */
+typedef enum
+{
+   DS_PACKET_IN_ORDER,
+   DS_PACKET_LATE,
+   DS_PACKET_DUPLICATE,
+} DS_PacketOrder;
+
+/**
+ * Tracks the 16-bit sequence numbers received on a link to detect lost,
+ * late (reordered) and duplicated packets. The last 64 sequence numbers are
+ * kept in a bitmap, a packet that leaves the bitmap without being received is
+ * counted as lost.
+ */
+typedef struct _loss_tracker
+{
+   int initialized; /**< Set to \c 1 after the first packet */
+   int filled; /**< Number of valid positions in \a window */
+   uint16_t highest; /**< Highest sequence number received */
+   uint64_t window; /**< Received packets, bit \c n is \a highest - \c n */
+   uint64_t received; /**< Number of packets received (excluding duplicates) */
+   uint64_t lost; /**< Number of packets that left the window unreceived */
+   uint64_t late; /**< Number of packets received out of order */
+   uint64_t duplicates; /**< Number of packets received more than once */
+   uint64_t period[DS_LOSS_PERIODS]; /**< Second of each history slot */
+   uint32_t expected[DS_LOSS_PERIODS]; /**< Packets expected in each second */
+   uint32_t arrived[DS_LOSS_PERIODS]; /**< Packets received in each second */
+} DS_LossTracker;
+
+extern void DS_LossTrackerReset(DS_LossTracker *tracker);
+extern void DS_LossTrackerResync(DS_LossTracker *tracker);
+extern double DS_LossTrackerLoss(const DS_LossTracker *tracker, const uint64_t now, const int seconds);
+extern DS_PacketOrder DS_LossTrackerRecord(DS_LossTracker *tracker, const uint16_t sequence, const uint64_t time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,102 +1,226 @@
-/*
- * The Driver Station Library (LibDS)
- * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
- *
- * Permission is hereby granted, free of charge, to any person obtaining
- * a copy of this software and associated documentation files (the "Software"),
- * to deal in the Software without restriction, including without limitation
- * the rights to use, copy, modify, merge, publish, distribute, sublicense,
- * and/or sell copies of the Software, and to permit persons to whom the
- * Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
- * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-
-#ifndef _LIB_DS_PROTOCOL_H
-#define _LIB_DS_PROTOCOL_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-#include "DS_Socket.h"
-#include "DS_String.h"
-
-typedef struct _protocol
-{
-   DS_String name;
-   DS_String (*fms_address)(void);
-   DS_String (*radio_address)(void);
-   DS_String (*robot_address)(void);
-
-   DS_String (*create_fms_packet)(void);
-   DS_String (*create_radio_packet)(void);
-   DS_String (*create_robot_packet)(void);
-
-   int (*read_fms_packet)(const DS_String *);
-   int (*read_radio_packet)(const DS_String *);
-   int (*read_robot_packet)(const DS_String *);
-
-   void (*reset_fms)(void);
-   void (*reset_radio)(void);
-   void (*reset_robot)(void);
-
-   void (*reboot_robot)(void);
-   void (*restart_robot_code)(void);
-
-   int fms_interval;
-   int radio_interval;
-   int robot_interval;
-
-   int max_joysticks;
-   int max_axis_count;
-   int max_hat_count;
-   int max_button_count;
-   float max_battery_voltage;
-
-   DS_Socket fms_socket;
-   DS_Socket radio_socket;
-   DS_Socket robot_socket;
-   DS_Socket netconsole_socket;
-} DS_Protocol;
-
-extern void Protocols_Init();
-extern void Protocols_Close();
-extern void DS_ConfigureProtocol(const DS_Protocol *ptr);
-
-extern unsigned long DS_SentFMSBytes();
-extern unsigned long DS_SentRadioBytes();
-extern unsigned long DS_SentRobotBytes();
-
-extern unsigned long DS_ReceivedFMSBytes();
-extern unsigned long DS_ReceivedRadioBytes();
-extern unsigned long DS_ReceivedRobotBytes();
-
-extern int DS_SentFMSPackets();
-extern int DS_SentRadioPackets();
-extern int DS_SentRobotPackets();
-
-extern int DS_ReceivedFMSPackets();
-extern int DS_ReceivedRadioPackets();
-extern int DS_ReceivedRobotPackets();
-
-extern void DS_ResetFMSPackets();
-extern void DS_ResetRadioPackets();
-extern void DS_ResetRobotPackets();
-
-extern DS_Protocol *DS_CurrentProtocol();
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef _LIB_DS_PROTOCOL_H
+#define _LIB_DS_PROTOCOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "DS_Socket.h"
+#include "DS_String.h"
+
+/**
+ * Holds the functions and settings of a communication protocol. The optional
+ * members (marked below) must be zero when they are not used, so initialize
+ * the structure with \c DS_ProtocolEmpty() before filling it.
+ */
+typedef struct _protocol
+{
+   DS_String name;
+   DS_String (*fms_address)(void);
+   DS_String (*radio_address)(void);
+   DS_String (*robot_address)(void);
+
+   DS_String (*create_fms_packet)(void);
+   DS_String (*create_radio_packet)(void);
+   DS_String (*create_robot_packet)(void);
+   void (*update_robot_packet)(DS_String *view); /* Optional, see send_robot_data() */
+
+   int (*read_fms_packet)(const DS_String *);
+   int (*read_radio_packet)(const DS_String *);
+   int (*read_robot_packet)(const DS_String *);
+
+   void (*reset_fms)(void);
+   void (*reset_radio)(void);
+   void (*reset_robot)(void);
+
+   void (*reboot_robot)(void);
+   void (*restart_robot_code)(void);
+
+   int fms_interval;
+   int radio_interval;
+   int robot_interval;
+
+   int fms_sends_sequence; /* Optional, see track_loss() */
+   int robot_echoes_sequence; /* Optional, see record_trip_time() */
+
+   int max_joysticks;
+   int max_axis_count;
+   int max_hat_count;
+   int max_button_count;
+   float max_battery_voltage;
+
+   void *private_data; /* Optional, owned by the protocol */
+   void (*free_private_data)(void *); /* Optional, deletes private_data */
+
+   /* The sockets must be the last members (see DS_ConfigureProtocol()) */
+   DS_Socket fms_socket;
+   DS_Socket radio_socket;
+   DS_Socket robot_socket;
+   DS_Socket netconsole_socket;
+} DS_Protocol;
+
+/**
+ * Holds the traffic counters of the current protocol
+ */
+typedef struct _statistics
+{
+   uint64_t sent_fms_packets; /**< Packets sent to the FMS */
+   uint64_t sent_radio_packets; /**< Packets sent to the radio */
+   uint64_t sent_robot_packets; /**< Packets sent to the robot */
+   uint64_t received_fms_packets; /**< Packets received from the FMS */
+   uint64_t received_radio_packets; /**< Packets received from the radio */
+   uint64_t received_robot_packets; /**< Packets received from the robot */
+   uint64_t sent_fms_bytes; /**< Bytes sent to the FMS */
+   uint64_t sent_radio_bytes; /**< Bytes sent to the radio */
+   uint64_t sent_robot_bytes; /**< Bytes sent to the robot */
+   uint64_t received_fms_bytes; /**< Bytes received from the FMS */
+   uint64_t received_radio_bytes; /**< Bytes received from the radio */
+   uint64_t received_robot_bytes; /**< Bytes received from the robot */
+} DS_Statistics;
+
+/**
+ * Holds the send cadence of a link (in nanoseconds): the time between two
+ * consecutive packets (interval) and the delay of each packet relative to its
+ * scheduled deadline (lateness)
+ */
+typedef struct _send_statistics
+{
+   uint64_t samples; /**< Number of packets sent */
+   uint64_t interval_mean; /**< Average interval */
+   uint64_t interval_p50; /**< Median interval */
+   uint64_t interval_p99; /**< 99th percentile of the interval */
+   uint64_t interval_p999; /**< 99.9th percentile of the interval */
+   uint64_t interval_max; /**< Largest interval */
+   uint64_t lateness_mean; /**< Average lateness */
+   uint64_t lateness_p50; /**< Median lateness */
+   uint64_t lateness_p99; /**< 99th percentile of the lateness */
+   uint64_t lateness_p999; /**< 99.9th percentile of the lateness */
+   uint64_t lateness_max; /**< Largest lateness */
+} DS_SendStatistics;
+
+/**
+ * Holds the round-trip time to the robot (in nanoseconds), measured with the
+ * sequence numbers that the robot echoes in its replies
+ */
+typedef struct _trip_time_statistics
+{
+   uint64_t samples; /**< Number of measured round trips */
+   uint64_t last; /**< Last measured round-trip time */
+   uint64_t min; /**< Shortest round-trip time */
+   uint64_t max; /**< Longest round-trip time */
+   uint64_t mean; /**< Average round-trip time */
+   uint64_t ewma; /**< Moving average of the round-trip time (1/8 weight) */
+   uint64_t p50; /**< Median round-trip time */
+   uint64_t p99; /**< 99th percentile of the round-trip time */
+   uint64_t p999; /**< 99.9th percentile of the round-trip time */
+} DS_TripTimeStatistics;
+
+/**
+ * Holds the packet loss of a link, detected with the sequence numbers of the
+ * received packets
+ */
+typedef struct _loss_statistics
+{
+   uint64_t received; /**< Number of packets received (excluding duplicates) */
+   uint64_t lost; /**< Number of packets that were never received */
+   uint64_t late; /**< Number of packets received out of order */
+   uint64_t duplicates; /**< Number of packets received more than once */
+   double loss; /**< Loss percentage during the loss window */
+   int high; /**< Set to \c 1 if the loss is above the threshold */
+} DS_LossStatistics;
+
+/**
+ * Holds the time (in nanoseconds) between the arrival of the packets of a
+ * link and the moment in which the protocol finished reading them
+ */
+typedef struct _latency_statistics
+{
+   uint64_t samples; /**< Number of read packets */
+   uint64_t last; /**< Latency of the last packet */
+   uint64_t min; /**< Shortest latency */
+   uint64_t max; /**< Longest latency */
+   uint64_t mean; /**< Average latency */
+   uint64_t p50; /**< Median latency */
+   uint64_t p99; /**< 99th percentile of the latency */
+   uint64_t p999; /**< 99.9th percentile of the latency */
+} DS_LatencyStatistics;
+
+extern void Protocols_Init();
+extern void Protocols_Close();
+extern void Protocols_Lock();
+extern void Protocols_Unlock();
+extern DS_Protocol DS_ProtocolEmpty(void);
+extern void DS_ConfigureProtocol(const DS_Protocol *ptr);
+extern int DS_SetRealtimeOptions(const DS_RealtimeOptions *options);
+
+extern unsigned long DS_SentFMSBytes();
+extern unsigned long DS_SentRadioBytes();
+extern unsigned long DS_SentRobotBytes();
+
+extern unsigned long DS_ReceivedFMSBytes();
+extern unsigned long DS_ReceivedRadioBytes();
+extern unsigned long DS_ReceivedRobotBytes();
+
+extern int DS_SentFMSPackets();
+extern int DS_SentRadioPackets();
+extern int DS_SentRobotPackets();
+
+extern int DS_ReceivedFMSPackets();
+extern int DS_ReceivedRadioPackets();
+extern int DS_ReceivedRobotPackets();
+
+extern uint64_t DS_LastFMSPacketTime();
+extern uint64_t DS_LastRadioPacketTime();
+extern uint64_t DS_LastRobotPacketTime();
+
+extern void DS_ResetFMSPackets();
+extern void DS_ResetRadioPackets();
+extern void DS_ResetRobotPackets();
+
+extern void DS_GetStatistics(DS_Statistics *stats);
+
+extern void DS_ResetSendStatistics();
+extern void DS_GetSendStatistics(const DS_Link link, DS_SendStatistics *stats);
+
+extern void DS_ResetRobotTripTime();
+extern void DS_GetRobotTripTime(DS_TripTimeStatistics *stats);
+extern uint64_t DS_RobotTripTimePercentile(const double percentile);
+
+extern void DS_ResetLossStatistics();
+extern void DS_SetLossWindow(const int seconds);
+extern void DS_SetLossThreshold(const double percent);
+extern void DS_GetLossStatistics(const DS_Link link, DS_LossStatistics *stats);
+
+extern void DS_ResetReceiveLatency();
+extern void DS_GetReceiveLatency(const DS_Link link, DS_LatencyStatistics *stats);
+
+extern DS_Protocol *DS_CurrentProtocol();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
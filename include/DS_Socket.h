@@ -1,87 +1,192 @@
-/*
- * The Driver Station Library (LibDS)
- * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
- *
- * Permission is hereby granted, free of charge, to any person obtaining
- * a copy of this software and associated documentation files (the "Software"),
- * to deal in the Software without restriction, including without limitation
- * the rights to use, copy, modify, merge, publish, distribute, sublicense,
- * and/or sell copies of the Software, and to permit persons to whom the
- * Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
- * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-
-#ifndef _LIB_DS_SOCKET_H
-#define _LIB_DS_SOCKET_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-#include <pthread.h>
-
-#include "DS_Types.h"
-#include "DS_String.h"
-
-/**
- * Holds all the private (erm, dirty) variables that the sockets module needs
- * to operate with the data provided by a \c DS_Socket structure
- */
-typedef struct
-{
-   int sock_in; /**< Input socket file descriptor */
-   int sock_out; /**< Output socket file descriptor */
-   int client_init; /**< 1 if client is working, 0 if not */
-   int server_init; /**< 1 if server is working, 0 if not */
-   size_t buffer_size; /**< Holds the number of received bytes */
-   char buffer[4096]; /**< Holds the received data buffer */
-   char in_service[12]; /**< Holds the input port number as a string */
-   char out_service[12]; /**< Holds the output port number as a string */
-} DS_SocketInfo;
-
-/**
- * Holds all the 'public' variables of a socket, these variables can be used
- * both the the networking module and the rest of the application.
- */
-typedef struct
-{
-   int in_port; /**< Input port number */
-   int out_port; /**< Output port number */
-   int disabled; /**< 1 if socket shall not send or receive data */
-   int broadcast; /**< 1 if socket shall send or receive broadcasts */
-   char address[512]; /**< Address of remote host */
-   DS_SocketType type; /**< Type of socket (UDP/TCP) */
-   DS_SocketInfo info; /**< Ugly data about the socket */
-} DS_Socket;
-
-/* For socket initialization */
-extern DS_Socket *DS_SocketEmpty(void);
-
-/* Module functions */
-extern void Sockets_Init(void);
-extern void Sockets_Close(void);
-
-/* Socket initializer and destructor functions */
-extern void DS_SocketOpen(DS_Socket *ptr);
-extern void DS_SocketClose(DS_Socket *ptr);
-
-/* I/O functions */
-extern DS_String DS_SocketRead(DS_Socket *ptr);
-extern int DS_SocketSend(const DS_Socket *ptr, const DS_String *data);
-extern void DS_SocketChangeAddress(DS_Socket *ptr, const char *address);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef _LIB_DS_SOCKET_H
+#define _LIB_DS_SOCKET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include "DS_Types.h"
+#include "DS_Utils.h"
+#include "DS_String.h"
+
+/**
+ * Number of received datagrams that each socket can hold until they are read
+ */
+#define DS_SOCKET_RING_SIZE 16
+
+/**
+ * Maximum size of a received datagram
+ */
+#define DS_SOCKET_DATAGRAM_SIZE 4096
+
+/**
+ * Initial size of the stream buffer of TCP sockets
+ */
+#define DS_SOCKET_STREAM_SIZE 4096
+
+/**
+ * Maximum size of the stream buffer of TCP sockets (the largest frame)
+ */
+#define DS_SOCKET_STREAM_MAX (0xFFFF + 2)
+
+/**
+ * Maximum amount of TCP data that can wait to be sent
+ */
+#define DS_SOCKET_PENDING_MAX (4 * DS_SOCKET_STREAM_MAX)
+
+/**
+ * Holds a received datagram and its receive time
+ */
+typedef struct
+{
+   uint64_t time; /**< Receive time (in ns, see \c DS_GetMonotonicTime()) */
+   int kernel_time; /**< 1 if \a time was reported by the kernel */
+   size_t len; /**< Holds the number of received bytes */
+   char data[DS_SOCKET_DATAGRAM_SIZE]; /**< Holds the received data */
+} DS_SocketDatagram;
+
+/**
+ * Holds all the private (erm, dirty) variables that the sockets module needs
+ * to operate with the data provided by a \c DS_Socket structure
+ */
+typedef struct
+{
+   int sock_in; /**< Input socket file descriptor */
+   int sock_out; /**< Output socket file descriptor */
+   int client_init; /**< 1 if client is working, 0 if not */
+   int server_init; /**< 1 if server is working, 0 if not */
+   DS_SocketDatagram *ring; /**< Received datagrams (allocated on open) */
+   unsigned int ring_head; /**< Counter of datagrams released from the ring */
+   unsigned int ring_read; /**< Counter of datagrams read from the ring */
+   unsigned int ring_tail; /**< Counter of datagrams written to the ring */
+   unsigned long dropped; /**< Datagrams discarded because the ring was full */
+   char *stream; /**< Received TCP data (allocated on open) */
+   size_t stream_len; /**< Number of bytes in \a stream */
+   size_t stream_size; /**< Allocated size of \a stream */
+   size_t stream_read; /**< Number of bytes of \a stream that were read */
+   int stream_paused; /**< 1 if the reactor stopped reading the connection */
+   char *pending; /**< TCP data that could not be sent yet */
+   size_t pending_len; /**< Number of bytes in \a pending */
+   DS_SocketState state; /**< Connection state of TCP sockets */
+   int attempts; /**< Number of failed connection attempts */
+   uint64_t retry_time; /**< Time (in ns) of the next connection attempt */
+   char in_service[12]; /**< Holds the input port number as a string */
+   char out_service[12]; /**< Holds the output port number as a string */
+   uint64_t peer[16]; /**< Cached remote address (a \c sockaddr_storage) */
+   int peer_len; /**< Length of the cached remote address */
+   int peer_valid; /**< 1 if \a peer holds a resolved address */
+   int peer_stale; /**< 1 if \a peer must be resolved again */
+   int peer_generation; /**< Increased every time that the address changes */
+   uint64_t peer_time; /**< Time (in ns) of the last address lookup */
+   unsigned long lookups; /**< Number of address lookups performed */
+} DS_SocketInfo;
+
+/**
+ * Holds all the 'public' variables of a socket, these variables can be used
+ * both the the networking module and the rest of the application.
+ */
+typedef struct
+{
+   int in_port; /**< Input port number */
+   int out_port; /**< Output port number */
+   int disabled; /**< 1 if socket shall not send or receive data */
+   int broadcast; /**< 1 if socket shall send or receive broadcasts */
+   int timestamps; /**< 1 if the kernel shall timestamp received datagrams */
+   int backoff_min; /**< Delay (in ms) before reconnecting a TCP socket */
+   int backoff_max; /**< Maximum reconnection delay (in ms) */
+   int backoff_jitter; /**< Random variation of the delay (in percent) */
+   char address[512]; /**< Address of remote host */
+   DS_SocketType type; /**< Type of socket (UDP/TCP) */
+   DS_SocketTransport transport; /**< Network or in-process (loopback) */
+   void *user_data; /**< Set by the owner of the socket (not used here) */
+   DS_SocketInfo info; /**< Ugly data about the socket */
+} DS_Socket;
+
+/**
+ * Holds the statistics of the transmit queue
+ */
+typedef struct
+{
+   unsigned long batches; /**< Number of times that the queue was flushed */
+   unsigned long packets; /**< Number of packets sent by the queue */
+   unsigned long syscalls; /**< Number of system calls used to send them */
+   unsigned long errors; /**< Number of packets that could not be sent */
+   int last_packets; /**< Number of packets sent in the last batch */
+   int last_syscalls; /**< Number of system calls used by the last batch */
+} DS_TransmitStats;
+
+/**
+ * Called by the reactor thread when a socket receives new data
+ */
+typedef void (*DS_SocketCallback)(DS_Socket *ptr);
+
+/**
+ * Called by the reactor thread when the connection state of a TCP socket
+ * changes
+ */
+typedef void (*DS_SocketStateCallback)(DS_Socket *ptr, DS_SocketState state);
+
+/* For socket initialization */
+extern DS_Socket *DS_SocketEmpty(void);
+
+/* Module functions */
+extern void Sockets_Init(void);
+extern void Sockets_Close(void);
+extern int Sockets_SetRealtimeOptions(const DS_RealtimeOptions *options);
+extern void DS_SocketSetReadyCallback(DS_SocketCallback callback);
+extern void DS_SocketSetStateCallback(DS_SocketStateCallback callback);
+extern void DS_SocketSetDefaultTransport(DS_SocketTransport transport);
+
+/* Socket initializer and destructor functions */
+extern void DS_SocketOpen(DS_Socket *ptr);
+extern void DS_SocketClose(DS_Socket *ptr);
+
+/* I/O functions */
+extern DS_String DS_SocketRead(DS_Socket *ptr);
+extern void DS_SocketRelease(DS_Socket *ptr);
+extern int DS_SocketBorrow(DS_Socket *ptr, DS_String *view, uint64_t *time);
+extern int DS_SocketSend(DS_Socket *ptr, const DS_String *data);
+extern void DS_SocketChangeAddress(DS_Socket *ptr, const char *address);
+
+/* Transmit queue functions */
+extern void DS_SocketFlush(void);
+extern void DS_SocketTransmitStats(DS_TransmitStats *stats);
+extern int DS_SocketQueue(DS_Socket *ptr, const DS_String *data);
+
+/* Statistics functions */
+extern unsigned long DS_SocketDropped(const DS_Socket *ptr);
+
+/* Address cache functions */
+extern unsigned long DS_SocketLookups(const DS_Socket *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,917 @@
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "LibDS.h"
+#include "DS_Config.h"
+#include "DS_Context.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+/*
+ * Each thread has its own current context
+ */
+#if defined _MSC_VER
+#   define THREAD_LOCAL __declspec(thread)
+#else
+#   define THREAD_LOCAL __thread
+#endif
+
+/*
+ * Holds the state of each module, the modules allocate their state when they
+ * are initialized (with the context being current)
+ */
+struct _ds_context
+{
+   void *modules[DS_MODULE_COUNT];
+   struct _ds_context *next;
+};
+
+/*
+ * The default context (used by the global API) and the list of contexts
+ * created with DS_CreateContext()
+ */
+static DS_Context default_context;
+static DS_Context *contexts = NULL;
+static pthread_mutex_t contexts_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * The context used by the calling thread (NULL means the default context)
+ */
+static THREAD_LOCAL DS_Context *current = NULL;
+
+/**
+ * Initializes the modules of the given \a context
+ */
+static void open_modules(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+
+   Config_Init();
+   Client_Init();
+   Events_Init();
+   Joysticks_Init();
+   Protocols_Init();
+
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Stops the protocol of the given \a context and frees its modules
+ */
+static void close_modules(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+
+   Protocols_Close();
+   Joysticks_Close();
+   Events_Close();
+   Client_Close();
+   Config_Close();
+
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Initializes the modules of the default context
+ */
+void Contexts_Init(void)
+{
+   open_modules(&default_context);
+}
+
+/**
+ * Destroys every context that is still alive and closes the modules of the
+ * default context
+ */
+void Contexts_Close(void)
+{
+   while (contexts)
+      DS_DestroyContext(contexts);
+
+   close_modules(&default_context);
+}
+
+/**
+ * Returns the state of the given \a module in the current context
+ */
+void *DS_GetContextData(const DS_ContextModule module)
+{
+   return DS_CurrentContext()->modules[module];
+}
+
+/**
+ * Changes the state of the given \a module in the current context, this is
+ * called by the modules when they are initialized or closed
+ */
+void DS_SetContextData(const DS_ContextModule module, void *data)
+{
+   DS_CurrentContext()->modules[module] = data;
+}
+
+/**
+ * Creates a new driver station, with its own robot state, event queue,
+ * joysticks and protocol event loop. The sockets and timers are shared by
+ * every context.
+ *
+ * Use the \c DS_Context* functions (or \c DS_SetCurrentContext()) to
+ * operate the new context, and \c DS_DestroyContext() to delete it.
+ *
+ * \returns the new context, or \c NULL if the LibDS is not initialized or
+ *          the context cannot be allocated
+ */
+DS_Context *DS_CreateContext(void)
+{
+   /* Library is not initialized */
+   if (!DS_Initialized())
+      return NULL;
+
+   /* Allocate the context and its modules */
+   DS_Context *context = (DS_Context *)calloc(1, sizeof(DS_Context));
+   if (!context)
+      return NULL;
+
+   open_modules(context);
+
+   /* Register the context */
+   pthread_mutex_lock(&contexts_lock);
+   context->next = contexts;
+   contexts = context;
+   pthread_mutex_unlock(&contexts_lock);
+
+   return context;
+}
+
+/**
+ * Stops the protocol of the given \a context and frees its memory.
+ *
+ * If the \a context is the current context of the calling thread, the
+ * thread switches back to the default context. The \a context must not be
+ * current in any other application thread (and no other thread may be
+ * using it) when this function is called, since those threads would keep a
+ * dangling pointer. The protocol thread of the context is stopped here.
+ *
+ * \note The default context cannot be destroyed, it is closed by
+ *       \c DS_Close()
+ */
+void DS_DestroyContext(DS_Context *context)
+{
+   /* Check arguments */
+   assert(context);
+   assert(context != &default_context);
+
+   /* Unregister the context */
+   pthread_mutex_lock(&contexts_lock);
+   DS_Context **link = &contexts;
+   while (*link && *link != context)
+      link = &(*link)->next;
+   if (*link)
+      *link = context->next;
+   pthread_mutex_unlock(&contexts_lock);
+
+   /* Stop using the context */
+   if (current == context)
+      current = NULL;
+
+   /* Close its modules */
+   close_modules(context);
+   free(context);
+}
+
+/**
+ * Returns the default context, which is used by the threads that do not
+ * select another context
+ */
+DS_Context *DS_DefaultContext(void)
+{
+   return &default_context;
+}
+
+/**
+ * Returns the context used by the calling thread
+ */
+DS_Context *DS_CurrentContext(void)
+{
+   if (current)
+      return current;
+
+   return &default_context;
+}
+
+/**
+ * Makes the LibDS functions called by the calling thread operate on the given
+ * \a context (use \c NULL to select the default context).
+ *
+ * \returns the previous context of the thread
+ */
+DS_Context *DS_SetCurrentContext(DS_Context *context)
+{
+   DS_Context *previous = DS_CurrentContext();
+
+   if (context == &default_context)
+      current = NULL;
+   else
+      current = context;
+
+   return previous;
+}
+
+/**
+ * Calls \c DS_GetCustomFMSAddress() with the given \a context
+ */
+char *DS_ContextGetCustomFMSAddress(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetCustomFMSAddress();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetCustomRadioAddress() with the given \a context
+ */
+char *DS_ContextGetCustomRadioAddress(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetCustomRadioAddress();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetCustomRobotAddress() with the given \a context
+ */
+char *DS_ContextGetCustomRobotAddress(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetCustomRobotAddress();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetDefaultFMSAddress() with the given \a context
+ */
+char *DS_ContextGetDefaultFMSAddress(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetDefaultFMSAddress();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetDefaultRadioAddress() with the given \a context
+ */
+char *DS_ContextGetDefaultRadioAddress(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetDefaultRadioAddress();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetDefaultRobotAddress() with the given \a context
+ */
+char *DS_ContextGetDefaultRobotAddress(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetDefaultRobotAddress();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetAppliedFMSAddress() with the given \a context
+ */
+char *DS_ContextGetAppliedFMSAddress(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetAppliedFMSAddress();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetAppliedRadioAddress() with the given \a context
+ */
+char *DS_ContextGetAppliedRadioAddress(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetAppliedRadioAddress();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetAppliedRobotAddress() with the given \a context
+ */
+char *DS_ContextGetAppliedRobotAddress(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetAppliedRobotAddress();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetGameData() with the given \a context
+ */
+char *DS_ContextGetGameData(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetGameData();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetStatusString() with the given \a context
+ */
+char *DS_ContextGetStatusString(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   char *value = DS_GetStatusString();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetTeamNumber() with the given \a context
+ */
+int DS_ContextGetTeamNumber(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetTeamNumber();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetRobotCode() with the given \a context
+ */
+int DS_ContextGetRobotCode(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetRobotCode();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetCanBeEnabled() with the given \a context
+ */
+int DS_ContextGetCanBeEnabled(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetCanBeEnabled();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetRobotEnabled() with the given \a context
+ */
+int DS_ContextGetRobotEnabled(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetRobotEnabled();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetRobotCPUUsage() with the given \a context
+ */
+int DS_ContextGetRobotCPUUsage(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetRobotCPUUsage();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetRobotRAMUsage() with the given \a context
+ */
+int DS_ContextGetRobotRAMUsage(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetRobotRAMUsage();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetRobotDiskUsage() with the given \a context
+ */
+int DS_ContextGetRobotDiskUsage(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetRobotDiskUsage();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetRobotVoltage() with the given \a context
+ */
+float DS_ContextGetRobotVoltage(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   float value = DS_GetRobotVoltage();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetAlliance() with the given \a context
+ */
+DS_Alliance DS_ContextGetAlliance(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_Alliance value = DS_GetAlliance();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetPosition() with the given \a context
+ */
+DS_Position DS_ContextGetPosition(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_Position value = DS_GetPosition();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetEmergencyStopped() with the given \a context
+ */
+int DS_ContextGetEmergencyStopped(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetEmergencyStopped();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetFMSCommunications() with the given \a context
+ */
+int DS_ContextGetFMSCommunications(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetFMSCommunications();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetRadioCommunications() with the given \a context
+ */
+int DS_ContextGetRadioCommunications(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetRadioCommunications();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetRobotCommunications() with the given \a context
+ */
+int DS_ContextGetRobotCommunications(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetRobotCommunications();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetRobotCANUtilization() with the given \a context
+ */
+int DS_ContextGetRobotCANUtilization(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetRobotCANUtilization();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetControlMode() with the given \a context
+ */
+DS_ControlMode DS_ContextGetControlMode(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_ControlMode value = DS_GetControlMode();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetMaximumBatteryVoltage() with the given \a context
+ */
+float DS_ContextGetMaximumBatteryVoltage(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   float value = DS_GetMaximumBatteryVoltage();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_RebootRobot() with the given \a context
+ */
+void DS_ContextRebootRobot(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_RebootRobot();
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_RestartRobotCode() with the given \a context
+ */
+void DS_ContextRestartRobotCode(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_RestartRobotCode();
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetGameData() with the given \a context
+ */
+void DS_ContextSetGameData(DS_Context *context, const char *data)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetGameData(data);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetTeamNumber() with the given \a context
+ */
+void DS_ContextSetTeamNumber(DS_Context *context, const int team)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetTeamNumber(team);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetRobotEnabled() with the given \a context
+ */
+void DS_ContextSetRobotEnabled(DS_Context *context, const int enabled)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetRobotEnabled(enabled);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetEmergencyStopped() with the given \a context
+ */
+void DS_ContextSetEmergencyStopped(DS_Context *context, const int stop)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetEmergencyStopped(stop);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetAlliance() with the given \a context
+ */
+void DS_ContextSetAlliance(DS_Context *context, const DS_Alliance alliance)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetAlliance(alliance);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetPosition() with the given \a context
+ */
+void DS_ContextSetPosition(DS_Context *context, const DS_Position position)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetPosition(position);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetControlMode() with the given \a context
+ */
+void DS_ContextSetControlMode(DS_Context *context, const DS_ControlMode mode)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetControlMode(mode);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetCustomFMSAddress() with the given \a context
+ */
+void DS_ContextSetCustomFMSAddress(DS_Context *context, const char *address)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetCustomFMSAddress(address);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetCustomRadioAddress() with the given \a context
+ */
+void DS_ContextSetCustomRadioAddress(DS_Context *context, const char *address)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetCustomRadioAddress(address);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetCustomRobotAddress() with the given \a context
+ */
+void DS_ContextSetCustomRobotAddress(DS_Context *context, const char *address)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetCustomRobotAddress(address);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SendNetConsoleMessage() with the given \a context
+ */
+void DS_ContextSendNetConsoleMessage(DS_Context *context, const char *message)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SendNetConsoleMessage(message);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_PollEvent() with the given \a context
+ */
+int DS_ContextPollEvent(DS_Context *context, DS_Event *event)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_PollEvent(event);
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_WaitEvent() with the given \a context
+ */
+int DS_ContextWaitEvent(DS_Context *context, DS_Event *event, const int timeout)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_WaitEvent(event, timeout);
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetEventFd() with the given \a context
+ */
+int DS_ContextGetEventFd(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetEventFd();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetEventStatistics() with the given \a context
+ */
+void DS_ContextGetEventStatistics(DS_Context *context, DS_EventStatistics *stats)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_GetEventStatistics(stats);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_GetJoystickCount() with the given \a context
+ */
+int DS_ContextGetJoystickCount(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetJoystickCount();
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetJoystickNumHats() with the given \a context
+ */
+int DS_ContextGetJoystickNumHats(DS_Context *context, int joystick)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetJoystickNumHats(joystick);
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetJoystickNumAxes() with the given \a context
+ */
+int DS_ContextGetJoystickNumAxes(DS_Context *context, int joystick)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetJoystickNumAxes(joystick);
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetJoystickNumButtons() with the given \a context
+ */
+int DS_ContextGetJoystickNumButtons(DS_Context *context, int joystick)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetJoystickNumButtons(joystick);
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetJoystickHat() with the given \a context
+ */
+int DS_ContextGetJoystickHat(DS_Context *context, int joystick, int hat)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetJoystickHat(joystick, hat);
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetJoystickAxis() with the given \a context
+ */
+float DS_ContextGetJoystickAxis(DS_Context *context, int joystick, int axis)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   float value = DS_GetJoystickAxis(joystick, axis);
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetJoystickButton() with the given \a context
+ */
+int DS_ContextGetJoystickButton(DS_Context *context, int joystick, int button)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_GetJoystickButton(joystick, button);
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_JoysticksReset() with the given \a context
+ */
+void DS_ContextJoysticksReset(DS_Context *context)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_JoysticksReset();
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_JoysticksAdd() with the given \a context
+ */
+void DS_ContextJoysticksAdd(DS_Context *context, const int axes, const int hats, const int buttons)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_JoysticksAdd(axes, hats, buttons);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetJoystickHat() with the given \a context
+ */
+void DS_ContextSetJoystickHat(DS_Context *context, int joystick, int hat, int angle)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetJoystickHat(joystick, hat, angle);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetJoystickAxis() with the given \a context
+ */
+void DS_ContextSetJoystickAxis(DS_Context *context, int joystick, int axis, float value)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetJoystickAxis(joystick, axis, value);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetJoystickButton() with the given \a context
+ */
+void DS_ContextSetJoystickButton(DS_Context *context, int joystick, int button, int pressed)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_SetJoystickButton(joystick, button, pressed);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_ConfigureProtocol() with the given \a context
+ */
+void DS_ContextConfigureProtocol(DS_Context *context, const DS_Protocol *ptr)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_ConfigureProtocol(ptr);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_SetRealtimeOptions() with the given \a context
+ */
+int DS_ContextSetRealtimeOptions(DS_Context *context, const DS_RealtimeOptions *options)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   int value = DS_SetRealtimeOptions(options);
+   DS_SetCurrentContext(previous);
+   return value;
+}
+
+/**
+ * Calls \c DS_GetStatistics() with the given \a context
+ */
+void DS_ContextGetStatistics(DS_Context *context, DS_Statistics *stats)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_GetStatistics(stats);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_GetSendStatistics() with the given \a context
+ */
+void DS_ContextGetSendStatistics(DS_Context *context, const DS_Link link, DS_SendStatistics *stats)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_GetSendStatistics(link, stats);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_GetRobotTripTime() with the given \a context
+ */
+void DS_ContextGetRobotTripTime(DS_Context *context, DS_TripTimeStatistics *stats)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_GetRobotTripTime(stats);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_GetLossStatistics() with the given \a context
+ */
+void DS_ContextGetLossStatistics(DS_Context *context, const DS_Link link, DS_LossStatistics *stats)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_GetLossStatistics(link, stats);
+   DS_SetCurrentContext(previous);
+}
+
+/**
+ * Calls \c DS_GetReceiveLatency() with the given \a context
+ */
+void DS_ContextGetReceiveLatency(DS_Context *context, const DS_Link link, DS_LatencyStatistics *stats)
+{
+   DS_Context *previous = DS_SetCurrentContext(context);
+   DS_GetReceiveLatency(link, stats);
+   DS_SetCurrentContext(previous);
+}
@@ -1,80 +1,567 @@
-/*
- * The Driver Station Library (LibDS)
- * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
- *
- * Permission is hereby granted, free of charge, to any person obtaining
- * a copy of this software and associated documentation files (the "Software"),
- * to deal in the Software without restriction, including without limitation
- * the rights to use, copy, modify, merge, publish, distribute, sublicense,
- * and/or sell copies of the Software, and to permit persons to whom the
- * Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
- * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-
-#include "DS_Queue.h"
-#include "DS_Events.h"
-
-#include <string.h>
-#include <assert.h>
-#include <stdlib.h>
-
-static DS_Queue events;
-
-/**
- * Initializes the event queue with an initial support for 50 events
- */
-void Events_Init(void)
-{
-   DS_QueueInit(&events, 50, sizeof(DS_Event));
-}
-
-/**
- * De-allocates the event queue (that's all)
- */
-void Events_Close(void)
-{
-   DS_QueueFree(&events);
-}
-
-/**
- * Adds the given \a event to the event queue
- *
- * \param event the event to register in the event queue
- */
-void DS_AddEvent(DS_Event *event)
-{
-   assert(event);
-   DS_QueuePush(&events, (void *)event);
-}
-
-/**
- * Polls for currently pending events and copies the first event in the queue
- * to the given \a event object.
- *
- * \returns 1 if there are any pending events, or 0 if there are none available.
- *
- * \param event we write the obtained event data here
- */
-int DS_PollEvent(DS_Event *event)
-{
-   DS_Event *front = (DS_Event *)DS_QueueGetFirst(&events);
-
-   if (front)
-   {
-      DS_QueuePop(&events);
-      memcpy(event, front, sizeof(DS_Event));
-      return 1;
-   }
-
-   return 0;
-}
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "DS_Utils.h"
+#include "DS_Timer.h"
+#include "DS_Atomic.h"
+#include "DS_Events.h"
+#include "DS_Context.h"
+
+#include <errno.h>
+#include <string.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+/*
+ * The event descriptor is an eventfd on Linux and a pipe on other POSIX
+ * systems, it is not available on Windows
+ */
+#if defined(__linux__)
+#   define USE_EVENTFD
+#   include <unistd.h>
+#   include <sys/eventfd.h>
+#elif !defined(_WIN32)
+#   define USE_PIPE
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+#define QUEUE_MASK (DS_EVENT_QUEUE_SIZE - 1)
+#define TELEMETRY_TYPES 5 /* Number of coalesced event types */
+
+/*
+ * A slot of the event ring, its sequence number tells if the slot is free
+ * for the producer of a given position or ready for the consumer
+ */
+typedef struct _event_cell
+{
+   unsigned int sequence;
+   DS_Event event;
+} EventCell;
+
+/*
+ * Holds the event queue of a context: a bounded ring that can be written by
+ * any thread (the protocol thread, the socket thread and the application)
+ * and read by a single thread, without locks or allocations
+ */
+typedef struct _events
+{
+   unsigned int enqueue_pos; /* Next position claimed by a producer */
+   unsigned int dequeue_pos; /* Next position read by the consumer */
+   unsigned int queued; /* Number of events added to the queue */
+   unsigned int dropped; /* Number of events dropped because the queue was full */
+   unsigned int max_pending; /* Largest number of events waiting in the queue */
+   EventCell cells[DS_EVENT_QUEUE_SIZE];
+
+   /*
+    * Lets the consumer sleep until an event is added, producers only signal
+    * the condition while the consumer is waiting
+    */
+   unsigned int waiting;
+   pthread_mutex_t wait_lock;
+   pthread_cond_t wait_cond;
+
+   /*
+    * Descriptor that is readable while events are pending (created by
+    * DS_GetEventFd()), producers only write to it when it is not signaled
+    */
+   int read_fd;
+   int write_fd;
+   unsigned int fd_ready;
+   unsigned int fd_signaled;
+
+   /*
+    * Latest value of each telemetry event type, the queue holds a single
+    * event of each type while its value is pending (see telemetry_index())
+    */
+   unsigned int coalesced;
+   pthread_mutex_t telemetry_lock;
+   int telemetry_pending[TELEMETRY_TYPES];
+   DS_Event telemetry[TELEMETRY_TYPES];
+} Events;
+
+/**
+ * Returns the event queue of the current context
+ */
+static Events *events(void)
+{
+   return (Events *)DS_GetContextData(DS_MODULE_EVENTS);
+}
+
+/**
+ * Releases the memory owned by the given \a event
+ */
+static void free_event(DS_Event *event)
+{
+   if (event->type == DS_NETCONSOLE_NEW_MESSAGE)
+      DS_FREE(event->netconsole.message);
+}
+
+/**
+ * Returns the telemetry slot of the given event \a type, or \c -1 if the
+ * events of the given \a type are not coalesced.
+ *
+ * Telemetry events only report the latest value of a robot metric, so the
+ * application only needs the last one of them. State changes (e.g. enabled,
+ * comms or e-stop) are always delivered one by one.
+ */
+static int telemetry_index(const DS_EventType type)
+{
+   switch (type)
+   {
+      case DS_ROBOT_VOLTAGE_CHANGED:
+         return 0;
+      case DS_ROBOT_CAN_UTIL_CHANGED:
+         return 1;
+      case DS_ROBOT_CPU_INFO_CHANGED:
+         return 2;
+      case DS_ROBOT_RAM_INFO_CHANGED:
+         return 3;
+      case DS_ROBOT_DISK_INFO_CHANGED:
+         return 4;
+      default:
+         return -1;
+   }
+}
+
+/**
+ * Stores the value of the given telemetry \a event in the given \a slot
+ *
+ * \returns \c 1 if an event of the same type was already waiting in the
+ *          queue (which will deliver the new value instead)
+ */
+static int update_telemetry(Events *queue, const int slot, const DS_Event *event)
+{
+   pthread_mutex_lock(&queue->telemetry_lock);
+   int pending = queue->telemetry_pending[slot];
+   memcpy(&queue->telemetry[slot], event, sizeof(DS_Event));
+   queue->telemetry_pending[slot] = 1;
+   pthread_mutex_unlock(&queue->telemetry_lock);
+
+   return pending;
+}
+
+/**
+ * Copies the latest value of the given telemetry \a slot to the given
+ * \a event, and allows the next value to be queued again
+ */
+static void take_telemetry(Events *queue, const int slot, DS_Event *event)
+{
+   pthread_mutex_lock(&queue->telemetry_lock);
+   memcpy(event, &queue->telemetry[slot], sizeof(DS_Event));
+   queue->telemetry_pending[slot] = 0;
+   pthread_mutex_unlock(&queue->telemetry_lock);
+}
+
+/**
+ * Makes the event descriptor of the given \a queue readable (if it exists
+ * and it is not readable already)
+ */
+static void signal_fd(Events *queue)
+{
+   if (!DS_AtomicLoad(&queue->fd_ready))
+      return;
+
+   unsigned int expected = 0;
+   if (DS_AtomicLoad(&queue->fd_signaled) || !DS_AtomicCompareExchange(&queue->fd_signaled, &expected, 1))
+      return;
+
+   /* Allow the next event to try again if the write fails */
+#if defined(USE_EVENTFD)
+   uint64_t value = 1;
+   if (write(queue->write_fd, &value, sizeof(value)) < 0)
+      DS_AtomicStore(&queue->fd_signaled, 0);
+#elif defined(USE_PIPE)
+   char value = 1;
+   if (write(queue->write_fd, &value, sizeof(value)) < 0)
+      DS_AtomicStore(&queue->fd_signaled, 0);
+#endif
+}
+
+/**
+ * Makes the event descriptor of the given \a queue non-readable
+ *
+ * \note This function is called by the consumer when the queue is empty
+ */
+static void clear_fd(Events *queue)
+{
+   if (!DS_AtomicLoad(&queue->fd_ready) || !DS_AtomicLoad(&queue->fd_signaled))
+      return;
+
+   /* Drain the descriptor (producers do not write while it is signaled) */
+#if defined(USE_EVENTFD)
+   uint64_t value;
+   while (read(queue->read_fd, &value, sizeof(value)) > 0)
+      ;
+#elif defined(USE_PIPE)
+   char buffer[64];
+   while (read(queue->read_fd, buffer, sizeof(buffer)) > 0)
+      ;
+#endif
+
+   /* Let the next event signal the descriptor again */
+   DS_AtomicStore(&queue->fd_signaled, 0);
+   DS_AtomicFence();
+}
+
+/**
+ * Updates the largest number of pending events with the given \a pending
+ * number of events
+ */
+static void update_max_pending(Events *queue, const unsigned int pending)
+{
+   unsigned int max = DS_AtomicLoad(&queue->max_pending);
+   while (pending > max)
+   {
+      if (DS_AtomicCompareExchange(&queue->max_pending, &max, pending))
+         break;
+   }
+}
+
+/**
+ * Initializes the event queue of the current context
+ */
+void Events_Init(void)
+{
+   Events *queue = (Events *)calloc(1, sizeof(Events));
+
+   unsigned int i;
+   for (i = 0; i < DS_EVENT_QUEUE_SIZE; ++i)
+      queue->cells[i].sequence = i;
+
+   pthread_mutex_init(&queue->wait_lock, NULL);
+   pthread_mutex_init(&queue->telemetry_lock, NULL);
+   DS_CondInit(&queue->wait_cond);
+   queue->read_fd = -1;
+   queue->write_fd = -1;
+   DS_SetContextData(DS_MODULE_EVENTS, queue);
+}
+
+/**
+ * De-allocates the event queue and the pending events
+ */
+void Events_Close(void)
+{
+   DS_Event event;
+   while (DS_PollEvent(&event))
+      free_event(&event);
+
+   Events *queue = events();
+   DS_SetContextData(DS_MODULE_EVENTS, NULL);
+#if defined(USE_EVENTFD)
+   if (queue->read_fd >= 0)
+      close(queue->read_fd);
+#elif defined(USE_PIPE)
+   if (queue->read_fd >= 0)
+   {
+      close(queue->read_fd);
+      close(queue->write_fd);
+   }
+#endif
+   pthread_cond_destroy(&queue->wait_cond);
+   pthread_mutex_destroy(&queue->wait_lock);
+   pthread_mutex_destroy(&queue->telemetry_lock);
+   free(queue);
+}
+
+/**
+ * Writes the given \a event to a free slot of the ring, and obtains its
+ * \a position in the ring
+ *
+ * \returns \c 1 on success, \c 0 if the queue is full
+ */
+static int push_event(Events *queue, const DS_Event *event, unsigned int *position)
+{
+   EventCell *cell;
+
+   /* Claim a free slot */
+   unsigned int pos = DS_AtomicLoad(&queue->enqueue_pos);
+   while (1)
+   {
+      cell = &queue->cells[pos & QUEUE_MASK];
+      int diff = (int)(DS_AtomicLoad(&cell->sequence) - pos);
+
+      /* The slot is free, try to claim it */
+      if (diff == 0)
+      {
+         if (DS_AtomicCompareExchange(&queue->enqueue_pos, &pos, pos + 1))
+            break;
+      }
+
+      /* The slot has not been read yet, the queue is full */
+      else if (diff < 0)
+         return 0;
+
+      /* Another producer claimed the slot */
+      else
+         pos = DS_AtomicLoad(&queue->enqueue_pos);
+   }
+
+   /* Write the event and publish it to the consumer */
+   memcpy(&cell->event, event, sizeof(DS_Event));
+   DS_AtomicStore(&cell->sequence, pos + 1);
+   *position = pos;
+   return 1;
+}
+
+/**
+ * Adds the given \a event to the event queue, this function can be called
+ * from any thread.
+ *
+ * Telemetry events (voltage, CAN, CPU, RAM and disk usage) are coalesced:
+ * if an event of the same type is still waiting in the queue, it is updated
+ * with the new value instead of queuing a new event. Other events are
+ * delivered in the order in which they were added.
+ *
+ * The queue holds up to \c DS_EVENT_QUEUE_SIZE events. When the queue is
+ * full, the new event is dropped (the pending events are kept, so that the
+ * application still receives the oldest state changes) and the drop is
+ * counted, see \c DS_GetEventStatistics(). The memory owned by a dropped
+ * event (e.g. a NetConsole message) is released.
+ *
+ * \param event the event to register in the event queue
+ */
+void DS_AddEvent(DS_Event *event)
+{
+   assert(event);
+
+   Events *queue = events();
+
+   /* Update the pending telemetry event (if any) */
+   int slot = telemetry_index(event->type);
+   if (slot >= 0 && update_telemetry(queue, slot, event))
+   {
+      DS_AtomicFetchAdd(&queue->coalesced, 1);
+      return;
+   }
+
+   /* Add the event to the ring */
+   unsigned int pos;
+   if (!push_event(queue, event, &pos))
+   {
+      /* Let the next telemetry value try again */
+      if (slot >= 0)
+      {
+         DS_Event discarded;
+         take_telemetry(queue, slot, &discarded);
+      }
+
+      DS_AtomicFetchAdd(&queue->dropped, 1);
+      free_event(event);
+      return;
+   }
+
+   /* Wake the consumer if it is waiting for events */
+   DS_AtomicFence();
+   if (DS_AtomicLoad(&queue->waiting))
+   {
+      pthread_mutex_lock(&queue->wait_lock);
+      pthread_cond_signal(&queue->wait_cond);
+      pthread_mutex_unlock(&queue->wait_lock);
+   }
+
+   /* Make the event descriptor readable */
+   signal_fd(queue);
+
+   /* Update the statistics */
+   DS_AtomicFetchAdd(&queue->queued, 1);
+   update_max_pending(queue, pos + 1 - DS_AtomicLoad(&queue->dequeue_pos));
+}
+
+/**
+ * Polls for currently pending events and copies the first event in the queue
+ * to the given \a event object.
+ *
+ * \note The events of a context must be read by a single thread at a time
+ *
+ * \returns 1 if there are any pending events, or 0 if there are none available.
+ *
+ * \param event we write the obtained event data here
+ */
+int DS_PollEvent(DS_Event *event)
+{
+   assert(event);
+
+   Events *queue = events();
+   unsigned int pos = queue->dequeue_pos;
+   EventCell *cell = &queue->cells[pos & QUEUE_MASK];
+
+   /*
+    * The next event has not been published yet, clear the event descriptor
+    * and check again (an event published meanwhile may have seen the
+    * descriptor as signaled, and skipped signaling it)
+    */
+   if (DS_AtomicLoad(&cell->sequence) != pos + 1)
+   {
+      if (!DS_AtomicLoad(&queue->fd_signaled))
+         return 0;
+
+      clear_fd(queue);
+      if (DS_AtomicLoad(&cell->sequence) != pos + 1)
+         return 0;
+   }
+
+   /* Read the event and release its slot */
+   memcpy(event, &cell->event, sizeof(DS_Event));
+   DS_AtomicStore(&cell->sequence, pos + DS_EVENT_QUEUE_SIZE);
+   DS_AtomicStore(&queue->dequeue_pos, pos + 1);
+
+   /* Deliver the latest value of telemetry events */
+   int slot = telemetry_index(event->type);
+   if (slot >= 0)
+      take_telemetry(queue, slot, event);
+
+   return 1;
+}
+
+/**
+ * Waits until an event is available and copies it to the given \a event
+ * object, or returns after \a timeout milliseconds if no event is added
+ * in the meantime. This is useful for applications that would otherwise
+ * call \c DS_PollEvent() periodically.
+ *
+ * \note The events of a context must be read by a single thread at a time
+ *
+ * \param event we write the obtained event data here
+ * \param timeout maximum time to wait (in milliseconds), \c 0 returns
+ *        immediately and a negative value waits without time limit
+ *
+ * \returns 1 if an event was obtained, or 0 if the timeout expired
+ */
+int DS_WaitEvent(DS_Event *event, const int timeout)
+{
+   assert(event);
+
+   /* Do not sleep if there are pending events */
+   if (DS_PollEvent(event))
+      return 1;
+   else if (timeout == 0)
+      return 0;
+
+   Events *queue = events();
+   uint64_t deadline = DS_GetMonotonicTime() + (uint64_t)timeout * 1000000;
+
+   /*
+    * Announce that we are waiting before checking the queue again, so that
+    * producers that publish an event after the check signal the condition
+    */
+   int obtained = 0;
+   pthread_mutex_lock(&queue->wait_lock);
+   DS_AtomicStore(&queue->waiting, 1);
+   DS_AtomicFence();
+   while (!(obtained = DS_PollEvent(event)))
+   {
+      if (timeout < 0)
+         pthread_cond_wait(&queue->wait_cond, &queue->wait_lock);
+
+      else if (DS_CondWaitUntil(&queue->wait_cond, &queue->wait_lock, deadline) == ETIMEDOUT)
+      {
+         obtained = DS_PollEvent(event);
+         break;
+      }
+   }
+   DS_AtomicStore(&queue->waiting, 0);
+   pthread_mutex_unlock(&queue->wait_lock);
+
+   return obtained;
+}
+
+/**
+ * Returns a file descriptor that is readable while the current context has
+ * pending events, so that the events can be handled by the event loop of
+ * the application (e.g. with \c epoll, \c select() or \c QSocketNotifier).
+ * When the descriptor becomes readable, call \c DS_PollEvent() until it
+ * returns \c 0, which also makes the descriptor non-readable again.
+ *
+ * The descriptor is created on the first call and closed when the context
+ * is closed, do not read from it or close it.
+ *
+ * \note This function must be called by the thread that reads the events
+ *
+ * \returns the descriptor, or \c -1 if it is not supported (on Windows) or
+ *          cannot be created
+ */
+int DS_GetEventFd(void)
+{
+   Events *queue = events();
+   if (queue->read_fd >= 0)
+      return queue->read_fd;
+
+   /* Create the descriptor */
+#if defined(USE_EVENTFD)
+   queue->read_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+   queue->write_fd = queue->read_fd;
+#elif defined(USE_PIPE)
+   int fds[2];
+   if (pipe(fds) == 0)
+   {
+      fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+      fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+      fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+      fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+      queue->read_fd = fds[0];
+      queue->write_fd = fds[1];
+   }
+#endif
+
+   /* Signal the descriptor, there may be pending events already */
+   if (queue->read_fd >= 0)
+   {
+      DS_AtomicStore(&queue->fd_ready, 1);
+      signal_fd(queue);
+   }
+
+   return queue->read_fd;
+}
+
+/**
+ * Obtains the counters of the event queue of the current context
+ */
+void DS_GetEventStatistics(DS_EventStatistics *stats)
+{
+   assert(stats);
+
+   Events *queue = events();
+   unsigned int dequeue_pos = DS_AtomicLoad(&queue->dequeue_pos);
+   unsigned int enqueue_pos = DS_AtomicLoad(&queue->enqueue_pos);
+
+   stats->capacity = DS_EVENT_QUEUE_SIZE;
+   stats->pending = DS_Min(enqueue_pos - dequeue_pos, DS_EVENT_QUEUE_SIZE);
+   stats->queued = DS_AtomicLoad(&queue->queued);
+   stats->dropped = DS_AtomicLoad(&queue->dropped);
+   stats->coalesced = DS_AtomicLoad(&queue->coalesced);
+   stats->max_pending = DS_AtomicLoad(&queue->max_pending);
+}
+
+/**
+ * Resets the counters of the event queue of the current context
+ */
+void DS_ResetEventStatistics(void)
+{
+   Events *queue = events();
+   DS_AtomicStore(&queue->queued, 0);
+   DS_AtomicStore(&queue->dropped, 0);
+   DS_AtomicStore(&queue->coalesced, 0);
+   DS_AtomicStore(&queue->max_pending, 0);
+}
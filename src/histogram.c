@@ -0,0 +1,180 @@
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "DS_Histogram.h"
+
+#include <assert.h>
+#include <string.h>
+
+/**
+ * Returns the position of the highest bit set in the given \a value
+ */
+static int highest_bit(const uint64_t value)
+{
+#if defined(__GNUC__)
+   return 63 - __builtin_clzll(value);
+#else
+   int bit = 0;
+   uint64_t v = value;
+   while (v >>= 1)
+      ++bit;
+
+   return bit;
+#endif
+}
+
+/**
+ * Returns the bucket in which the given \a value is counted.
+ *
+ * Values below 2^sub_bits have their own bucket, larger values are counted in
+ * buckets of width 2^shift, where shift grows with the highest bit of the
+ * value. This requires no loops nor tables.
+ */
+static int bucket_index(const uint64_t value)
+{
+   /* Small values are exact */
+   if (value < (1 << DS_HISTOGRAM_SUB_BITS))
+      return (int)value;
+
+   /* Get the width of the bucket and the position of the value inside it */
+   int shift = highest_bit(value) - (DS_HISTOGRAM_SUB_BITS - 1);
+   int top = (int)(value >> shift) - (1 << (DS_HISTOGRAM_SUB_BITS - 1));
+
+   return (1 << DS_HISTOGRAM_SUB_BITS) + (shift - 1) * (1 << (DS_HISTOGRAM_SUB_BITS - 1)) + top;
+}
+
+/**
+ * Returns the value in the middle of the given bucket \a index, which is at
+ * most half of the bucket width away from every value counted in it
+ */
+static uint64_t bucket_value(const int index)
+{
+   /* Small values are exact */
+   if (index < (1 << DS_HISTOGRAM_SUB_BITS))
+      return (uint64_t)index;
+
+   /* Get the width and the first value of the bucket */
+   int offset = index - (1 << DS_HISTOGRAM_SUB_BITS);
+   int shift = offset / (1 << (DS_HISTOGRAM_SUB_BITS - 1)) + 1;
+   uint64_t top = (uint64_t)(offset % (1 << (DS_HISTOGRAM_SUB_BITS - 1)) + (1 << (DS_HISTOGRAM_SUB_BITS - 1)));
+
+   return (top << shift) + ((uint64_t)1 << (shift - 1));
+}
+
+/**
+ * Removes every value recorded by the given \a histogram
+ */
+void DS_HistogramReset(DS_Histogram *histogram)
+{
+   assert(histogram);
+   memset(histogram, 0, sizeof(DS_Histogram));
+}
+
+/**
+ * Adds the given \a value to the \a histogram. This function runs in constant
+ * time and does not allocate memory, so it can be used in the hot path.
+ *
+ * \param histogram the histogram in which to record the value
+ * \param value the value to record (e.g. a duration in nanoseconds)
+ */
+void DS_HistogramRecord(DS_Histogram *histogram, uint64_t value)
+{
+   /* Check arguments */
+   assert(histogram);
+
+   /* Clamp the value to the range of the histogram */
+   const uint64_t limit = ((uint64_t)1 << DS_HISTOGRAM_MAX_BITS) - 1;
+   if (value > limit)
+      value = limit;
+
+   /* Update the minimum and maximum values */
+   if (histogram->count == 0 || value < histogram->min)
+      histogram->min = value;
+   if (value > histogram->max)
+      histogram->max = value;
+
+   /* Count the value */
+   ++histogram->count;
+   histogram->total += value;
+   ++histogram->buckets[bucket_index(value)];
+}
+
+/**
+ * Returns the average of the values recorded by the given \a histogram,
+ * or \c 0 if the histogram is empty
+ */
+uint64_t DS_HistogramMean(const DS_Histogram *histogram)
+{
+   assert(histogram);
+
+   if (histogram->count == 0)
+      return 0;
+
+   return histogram->total / histogram->count;
+}
+
+/**
+ * Returns the value below which the given \a percentile of the recorded
+ * values fall (e.g. 99.9), with the precision of the histogram.
+ *
+ * \param histogram the histogram to query
+ * \param percentile the percentile to get (from 0 to 100)
+ *
+ * \returns the percentile value, or \c 0 if the histogram is empty
+ */
+uint64_t DS_HistogramPercentile(const DS_Histogram *histogram, const double percentile)
+{
+   /* Check arguments */
+   assert(histogram);
+
+   /* Histogram is empty */
+   if (histogram->count == 0)
+      return 0;
+
+   /* Get the number of values that must be below the percentile */
+   uint64_t target = (uint64_t)((percentile / 100.0) * (double)histogram->count + 0.5);
+   if (target < 1)
+      target = 1;
+   if (target > histogram->count)
+      target = histogram->count;
+
+   /* Find the bucket that holds the target value */
+   int i;
+   uint64_t seen = 0;
+   for (i = 0; i < DS_HISTOGRAM_BUCKETS; ++i)
+   {
+      seen += histogram->buckets[i];
+      if (seen >= target)
+      {
+         uint64_t value = bucket_value(i);
+         if (value > histogram->max)
+            value = histogram->max;
+         if (value < histogram->min)
+            value = histogram->min;
+
+         return value;
+      }
+   }
+
+   return histogram->max;
+}
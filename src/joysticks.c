@@ -1,292 +1,443 @@
-/*
- * The Driver Station Library (LibDS)
- * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
- *
- * Permission is hereby granted, free of charge, to any person obtaining
- * a copy of this software and associated documentation files (the "Software"),
- * to deal in the Software without restriction, including without limitation
- * the rights to use, copy, modify, merge, publish, distribute, sublicense,
- * and/or sell copies of the Software, and to permit persons to whom the
- * Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
- * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-
-#include "DS_Array.h"
-#include "DS_Config.h"
-#include "DS_Events.h"
-#include "DS_Joysticks.h"
-
-#include <stdio.h>
-
-/**
- * Represents a joystick and its information
- */
-typedef struct _joystick
-{
-   int *hats; /**< An array with the hat angles */
-   float *axes; /**< An array with the axis values */
-   int *buttons; /**< An array with the button states */
-   int num_axes; /**< The number of axes of the joystick */
-   int num_hats; /**< The number of hats of the joystick */
-   int num_buttons; /**< The number of buttons of the joystick */
-} DS_Joystick;
-
-/**
- * Holds all the joysticks
- */
-static DS_Array array;
-
-/**
- * Registers a joystick event to the LibDS event system
- */
-static void register_event()
-{
-   DS_Event event;
-   event.joystick.count = DS_GetJoystickCount();
-   event.joystick.type = DS_JOYSTICK_COUNT_CHANGED;
-   DS_AddEvent(&event);
-}
-
-/**
- * Returns the joystick structure at the given index
- * If the joystick does not exist, this function shall return \c NULL
- */
-static DS_Joystick *get_joystick(int joystick)
-{
-   if ((int)array.used > joystick)
-      return (DS_Joystick *)array.data[joystick];
-
-   return NULL;
-}
-
-/**
- * Returns \c true if the given \a joystick exists and is valid
- */
-static int joystick_exists(int joystick)
-{
-   if (DS_GetJoystickCount() > joystick)
-      return get_joystick(joystick) != NULL;
-
-   return 0;
-}
-
-/**
- * Initializes the joystick array, with an initial support for 6 joysticks
- */
-void Joysticks_Init(void)
-{
-   DS_ArrayInit(&array, 6);
-}
-
-/**
- * De-allocates the joystick array data
- */
-void Joysticks_Close(void)
-{
-   DS_ArrayFree(&array);
-   register_event();
-}
-
-/**
- * Returns the number of joysticks registered with the LibDS
- */
-int DS_GetJoystickCount(void)
-{
-   return (int)array.used;
-}
-
-/**
- * Returns the number of hats that the given \a joystick has.
- * If the joystick does not exist, this function will return \c 0
- */
-int DS_GetJoystickNumHats(int joystick)
-{
-   if (joystick_exists(joystick))
-      return get_joystick(joystick)->num_hats;
-
-   return 0;
-}
-
-/**
- * Returns the number of axes that the given \a joystick has.
- * If the joystick does not exist, this function will return \c 0
- */
-int DS_GetJoystickNumAxes(int joystick)
-{
-   if (joystick_exists(joystick))
-      return get_joystick(joystick)->num_axes;
-
-   return 0;
-}
-
-/**
- * Returns the number of buttons that the given \a joystick has.
- * If the joystick does not exist, this function will return \c 0
- */
-int DS_GetJoystickNumButtons(int joystick)
-{
-   if (joystick_exists(joystick))
-      return get_joystick(joystick)->num_buttons;
-
-   return 0;
-}
-
-/**
- * Returns the value that the given \a hat in the given \a joystick has.
- * If the joystick or hat do not exist, this function will return \c 0
- *
- * \note Regardless of protocol implementation, this function will return
- *       a neutral value if the robot is disabled. This is for additional
- *       safety!
- */
-int DS_GetJoystickHat(int joystick, int hat)
-{
-   if (CFG_GetRobotEnabled() && joystick_exists(joystick))
-   {
-      DS_Joystick *stick = get_joystick(joystick);
-
-      if (stick->num_hats > hat)
-         return stick->hats[hat];
-   }
-
-   return 0;
-}
-
-/**
- * Returns the value that the given \a axis in the given \a joystick has.
- * If the joystick or axis do not exist, this function will return \c 0
- *
- * \note Regardless of protocol implementation, this function will return
- *       a neutral value if the robot is disabled. This is for additional
- *       safety!
- */
-float DS_GetJoystickAxis(int joystick, int axis)
-{
-   if (CFG_GetRobotEnabled() && joystick_exists(joystick))
-   {
-      DS_Joystick *stick = get_joystick(joystick);
-
-      if (stick->num_axes > axis)
-         return stick->axes[axis];
-   }
-
-   return 0;
-}
-
-/**
- * Returns the value that the given \a button in the given \a joystick has.
- * If the joystick or button do not exist, this function will return \c 0
- *
- * \note Regardless of protocol implementation, this function will return
- *       a neutral value if the robot is disabled. This is for additional
- *       safety!
- */
-int DS_GetJoystickButton(int joystick, int button)
-{
-   if (CFG_GetRobotEnabled() && joystick_exists(joystick))
-   {
-      DS_Joystick *stick = get_joystick(joystick);
-
-      if (stick->num_buttons > button)
-         return stick->buttons[button];
-   }
-
-   return 0;
-}
-
-/**
- * Removes all the registered joysticks from the LibDS
- */
-void DS_JoysticksReset(void)
-{
-   DS_ArrayFree(&array);
-   DS_ArrayInit(&array, 6);
-
-   register_event();
-}
-
-/**
- * Registers a new joystick with the given number of \a axes, \a hats and
- * \a buttons. All joystick values are set to a neutral state to ensure
- * safe operation of the robot.
- */
-void DS_JoysticksAdd(const int axes, const int hats, const int buttons)
-{
-   /* Joystick is empty */
-   if (axes <= 0 && hats <= 0 && buttons <= 0)
-   {
-      fprintf(stderr, "DS_JoystickAdd: Cannot register empty joystick!\n");
-      return;
-   }
-
-   /* Allocate memory for a new joystick */
-   DS_Joystick *joystick = (DS_Joystick *)calloc(1, sizeof(DS_Joystick));
-
-   /* Set joystick properties */
-   joystick->num_axes = axes;
-   joystick->num_hats = hats;
-   joystick->num_buttons = buttons;
-
-   /* Set joystick value arrays */
-   joystick->hats = calloc(hats, sizeof(int));
-   joystick->axes = calloc(axes, sizeof(float));
-   joystick->buttons = calloc(buttons, sizeof(int));
-
-   /* Register the new joystick in the joystick list */
-   DS_ArrayInsert(&array, (void *)joystick);
-
-   /* Emit the joystick count changed event */
-   register_event();
-}
-
-/**
- * Updates the \a angle of the given \a hat in the given \a joystick
- */
-void DS_SetJoystickHat(int joystick, int hat, int angle)
-{
-   if (joystick_exists(joystick))
-   {
-      DS_Joystick *stick = get_joystick(joystick);
-
-      if (stick->num_hats > hat)
-         stick->hats[hat] = angle;
-   }
-}
-
-/**
- * Updates the \a value of the given \a axis in the given \a joystick
- */
-void DS_SetJoystickAxis(int joystick, int axis, float value)
-{
-   if (joystick_exists(joystick))
-   {
-      DS_Joystick *stick = get_joystick(joystick);
-
-      if (stick->num_axes > axis)
-         stick->axes[axis] = value;
-   }
-}
-
-/**
- * Updates the \a pressed state of the given \a button in the given \a joystick
- */
-void DS_SetJoystickButton(int joystick, int button, int pressed)
-{
-   if (joystick_exists(joystick))
-   {
-      DS_Joystick *stick = get_joystick(joystick);
-
-      if (stick->num_buttons > button)
-         stick->buttons[button] = (pressed > 0) ? 1 : 0;
-   }
-}
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "DS_Array.h"
+#include "DS_Atomic.h"
+#include "DS_Config.h"
+#include "DS_Context.h"
+#include "DS_Events.h"
+#include "DS_Joysticks.h"
+
+#include <stdio.h>
+#include <pthread.h>
+
+/**
+ * Represents a joystick and its information
+ */
+typedef struct _joystick
+{
+   int *hats; /**< An array with the hat angles */
+   float *axes; /**< An array with the axis values */
+   int *buttons; /**< An array with the button states */
+   int num_axes; /**< The number of axes of the joystick */
+   int num_hats; /**< The number of hats of the joystick */
+   int num_buttons; /**< The number of buttons of the joystick */
+   unsigned int version; /**< Increased when a value of the joystick changes */
+} DS_Joystick;
+
+/**
+ * Holds the joysticks of a context
+ */
+typedef struct _joysticks
+{
+   DS_Array array; /**< The registered joysticks */
+   unsigned int layout; /**< Increased when joysticks are added or removed */
+   pthread_mutex_t lock; /**< Guards the joysticks, see Joysticks_Lock() */
+} Joysticks;
+
+/**
+ * Returns the joystick module of the current context
+ */
+static Joysticks *module(void)
+{
+   return (Joysticks *)DS_GetContextData(DS_MODULE_JOYSTICKS);
+}
+
+/**
+ * Returns the joysticks of the current context
+ */
+static DS_Array *joysticks(void)
+{
+   return &module()->array;
+}
+
+/**
+ * Increases the given \a version counter, the new value is published after
+ * the changes made before calling this function
+ */
+static void increase_version(unsigned int *version)
+{
+   DS_AtomicStore(version, *version + 1);
+}
+
+/**
+ * Registers a joystick event to the LibDS event system
+ */
+static void register_event()
+{
+   DS_Event event;
+   event.joystick.count = DS_GetJoystickCount();
+   event.joystick.type = DS_JOYSTICK_COUNT_CHANGED;
+   DS_AddEvent(&event);
+}
+
+/**
+ * Returns the joystick structure at the given index
+ * If the joystick does not exist, this function shall return \c NULL
+ */
+static DS_Joystick *get_joystick(int joystick)
+{
+   DS_Array *array = joysticks();
+   if ((int)array->used > joystick)
+      return (DS_Joystick *)array->data[joystick];
+
+   return NULL;
+}
+
+/**
+ * Returns \c true if the given \a joystick exists and is valid
+ */
+static int joystick_exists(int joystick)
+{
+   if (DS_GetJoystickCount() > joystick)
+      return get_joystick(joystick) != NULL;
+
+   return 0;
+}
+
+/**
+ * Initializes the joystick array, with an initial support for 6 joysticks
+ */
+void Joysticks_Init(void)
+{
+   Joysticks *js = (Joysticks *)calloc(1, sizeof(Joysticks));
+   DS_ArrayInit(&js->array, 6);
+
+   /* Initialize the joystick lock (it is recursive, see Joysticks_Lock()) */
+   pthread_mutexattr_t attributes;
+   pthread_mutexattr_init(&attributes);
+   pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+   pthread_mutex_init(&js->lock, &attributes);
+   pthread_mutexattr_destroy(&attributes);
+
+   DS_SetContextData(DS_MODULE_JOYSTICKS, js);
+}
+
+/**
+ * De-allocates the joystick array data
+ */
+void Joysticks_Close(void)
+{
+   Joysticks *js = module();
+   DS_ArrayFree(&js->array);
+   register_event();
+
+   DS_SetContextData(DS_MODULE_JOYSTICKS, NULL);
+   pthread_mutex_destroy(&js->lock);
+   free(js);
+}
+
+/**
+ * Prevents the joysticks of the current context from being added, removed or
+ * updated. Protocols hold the lock while they lay out and encode the joystick
+ * data, so that the sizes that they read stay valid until they are done.
+ *
+ * \note The lock is recursive, every call must be matched by a call to
+ *       \c Joysticks_Unlock()
+ */
+void Joysticks_Lock(void)
+{
+   pthread_mutex_lock(&module()->lock);
+}
+
+/**
+ * Releases the lock obtained with \c Joysticks_Lock()
+ */
+void Joysticks_Unlock(void)
+{
+   pthread_mutex_unlock(&module()->lock);
+}
+
+/**
+ * Returns the number of joysticks registered with the LibDS
+ */
+int DS_GetJoystickCount(void)
+{
+   Joysticks_Lock();
+   int count = (int)joysticks()->used;
+   Joysticks_Unlock();
+
+   return count;
+}
+
+/**
+ * Returns the number of hats that the given \a joystick has.
+ * If the joystick does not exist, this function will return \c 0
+ */
+int DS_GetJoystickNumHats(int joystick)
+{
+   int value = 0;
+
+   Joysticks_Lock();
+   if (joystick_exists(joystick))
+      value = get_joystick(joystick)->num_hats;
+   Joysticks_Unlock();
+
+   return value;
+}
+
+/**
+ * Returns the number of axes that the given \a joystick has.
+ * If the joystick does not exist, this function will return \c 0
+ */
+int DS_GetJoystickNumAxes(int joystick)
+{
+   int value = 0;
+
+   Joysticks_Lock();
+   if (joystick_exists(joystick))
+      value = get_joystick(joystick)->num_axes;
+   Joysticks_Unlock();
+
+   return value;
+}
+
+/**
+ * Returns the number of buttons that the given \a joystick has.
+ * If the joystick does not exist, this function will return \c 0
+ */
+int DS_GetJoystickNumButtons(int joystick)
+{
+   int value = 0;
+
+   Joysticks_Lock();
+   if (joystick_exists(joystick))
+      value = get_joystick(joystick)->num_buttons;
+   Joysticks_Unlock();
+
+   return value;
+}
+
+/**
+ * Returns the value that the given \a hat in the given \a joystick has.
+ * If the joystick or hat do not exist, this function will return \c 0
+ *
+ * \note Regardless of protocol implementation, this function will return
+ *       a neutral value if the robot is disabled. This is for additional
+ *       safety!
+ */
+int DS_GetJoystickHat(int joystick, int hat)
+{
+   int value = 0;
+
+   Joysticks_Lock();
+   if (CFG_GetRobotEnabled() && joystick_exists(joystick))
+   {
+      DS_Joystick *stick = get_joystick(joystick);
+
+      if (stick->num_hats > hat)
+         value = stick->hats[hat];
+   }
+   Joysticks_Unlock();
+
+   return value;
+}
+
+/**
+ * Returns the value that the given \a axis in the given \a joystick has.
+ * If the joystick or axis do not exist, this function will return \c 0
+ *
+ * \note Regardless of protocol implementation, this function will return
+ *       a neutral value if the robot is disabled. This is for additional
+ *       safety!
+ */
+float DS_GetJoystickAxis(int joystick, int axis)
+{
+   float value = 0;
+
+   Joysticks_Lock();
+   if (CFG_GetRobotEnabled() && joystick_exists(joystick))
+   {
+      DS_Joystick *stick = get_joystick(joystick);
+
+      if (stick->num_axes > axis)
+         value = stick->axes[axis];
+   }
+   Joysticks_Unlock();
+
+   return value;
+}
+
+/**
+ * Returns the value that the given \a button in the given \a joystick has.
+ * If the joystick or button do not exist, this function will return \c 0
+ *
+ * \note Regardless of protocol implementation, this function will return
+ *       a neutral value if the robot is disabled. This is for additional
+ *       safety!
+ */
+int DS_GetJoystickButton(int joystick, int button)
+{
+   int value = 0;
+
+   Joysticks_Lock();
+   if (CFG_GetRobotEnabled() && joystick_exists(joystick))
+   {
+      DS_Joystick *stick = get_joystick(joystick);
+
+      if (stick->num_buttons > button)
+         value = stick->buttons[button];
+   }
+   Joysticks_Unlock();
+
+   return value;
+}
+
+/**
+ * Returns a counter that is increased every time that joysticks are added or
+ * removed. Protocols can compare it with a previous value to know if they
+ * need to re-create the joystick data that they send to the robot
+ */
+unsigned int DS_GetJoystickLayoutVersion(void)
+{
+   return DS_AtomicLoad(&module()->layout);
+}
+
+/**
+ * Returns a counter that is increased every time that a value of the given
+ * \a joystick changes. If the joystick does not exist, this function will
+ * return \c 0
+ *
+ * \note The version of a joystick is only meaningful while the value of
+ *       \c DS_GetJoystickLayoutVersion() stays the same
+ */
+unsigned int DS_GetJoystickVersion(int joystick)
+{
+   unsigned int version = 0;
+
+   Joysticks_Lock();
+   if (joystick_exists(joystick))
+      version = DS_AtomicLoad(&get_joystick(joystick)->version);
+   Joysticks_Unlock();
+
+   return version;
+}
+
+/**
+ * Removes all the registered joysticks from the LibDS
+ */
+void DS_JoysticksReset(void)
+{
+   Joysticks_Lock();
+   DS_ArrayFree(joysticks());
+   DS_ArrayInit(joysticks(), 6);
+   increase_version(&module()->layout);
+   Joysticks_Unlock();
+
+   register_event();
+}
+
+/**
+ * Registers a new joystick with the given number of \a axes, \a hats and
+ * \a buttons. All joystick values are set to a neutral state to ensure
+ * safe operation of the robot.
+ */
+void DS_JoysticksAdd(const int axes, const int hats, const int buttons)
+{
+   /* Joystick is empty */
+   if (axes <= 0 && hats <= 0 && buttons <= 0)
+   {
+      fprintf(stderr, "DS_JoystickAdd: Cannot register empty joystick!\n");
+      return;
+   }
+
+   /* Allocate memory for a new joystick */
+   DS_Joystick *joystick = (DS_Joystick *)calloc(1, sizeof(DS_Joystick));
+
+   /* Set joystick properties */
+   joystick->num_axes = axes;
+   joystick->num_hats = hats;
+   joystick->num_buttons = buttons;
+
+   /* Set joystick value arrays */
+   joystick->hats = calloc(hats, sizeof(int));
+   joystick->axes = calloc(axes, sizeof(float));
+   joystick->buttons = calloc(buttons, sizeof(int));
+
+   /* Register the new joystick in the joystick list */
+   Joysticks_Lock();
+   DS_ArrayInsert(joysticks(), (void *)joystick);
+   increase_version(&module()->layout);
+   Joysticks_Unlock();
+
+   /* Emit the joystick count changed event */
+   register_event();
+}
+
+/**
+ * Updates the \a angle of the given \a hat in the given \a joystick
+ */
+void DS_SetJoystickHat(int joystick, int hat, int angle)
+{
+   Joysticks_Lock();
+   if (joystick_exists(joystick))
+   {
+      DS_Joystick *stick = get_joystick(joystick);
+
+      if (stick->num_hats > hat && stick->hats[hat] != angle)
+      {
+         stick->hats[hat] = angle;
+         increase_version(&stick->version);
+      }
+   }
+   Joysticks_Unlock();
+}
+
+/**
+ * Updates the \a value of the given \a axis in the given \a joystick
+ */
+void DS_SetJoystickAxis(int joystick, int axis, float value)
+{
+   Joysticks_Lock();
+   if (joystick_exists(joystick))
+   {
+      DS_Joystick *stick = get_joystick(joystick);
+
+      if (stick->num_axes > axis && stick->axes[axis] != value)
+      {
+         stick->axes[axis] = value;
+         increase_version(&stick->version);
+      }
+   }
+   Joysticks_Unlock();
+}
+
+/**
+ * Updates the \a pressed state of the given \a button in the given \a joystick
+ */
+void DS_SetJoystickButton(int joystick, int button, int pressed)
+{
+   Joysticks_Lock();
+   if (joystick_exists(joystick))
+   {
+      DS_Joystick *stick = get_joystick(joystick);
+
+      int state = (pressed > 0) ? 1 : 0;
+      if (stick->num_buttons > button && stick->buttons[button] != state)
+      {
+         stick->buttons[button] = state;
+         increase_version(&stick->version);
+      }
+   }
+   Joysticks_Unlock();
+}
@@ -0,0 +1,213 @@
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "DS_LossTracker.h"
+
+#include <assert.h>
+#include <string.h>
+
+/**
+ * Returns the number of bits set in the given \a value
+ */
+static int count_bits(const uint64_t value)
+{
+#if defined(__GNUC__)
+   return __builtin_popcountll(value);
+#else
+   int bits = 0;
+   uint64_t v = value;
+   while (v)
+   {
+      v &= v - 1;
+      ++bits;
+   }
+
+   return bits;
+#endif
+}
+
+/**
+ * Returns the history slot of the second that contains the given \a time,
+ * the slot is cleared if it belongs to an older second
+ */
+static int history_slot(DS_LossTracker *tracker, const uint64_t time)
+{
+   uint64_t second = time / 1000000000;
+   int slot = (int)(second % DS_LOSS_PERIODS);
+
+   if (tracker->period[slot] != second)
+   {
+      tracker->period[slot] = second;
+      tracker->expected[slot] = 0;
+      tracker->arrived[slot] = 0;
+   }
+
+   return slot;
+}
+
+/**
+ * Starts tracking the sequence numbers from the given \a sequence
+ */
+static void synchronize(DS_LossTracker *tracker, const uint16_t sequence)
+{
+   tracker->filled = 1;
+   tracker->window = 1;
+   tracker->initialized = 1;
+   tracker->highest = sequence;
+}
+
+/**
+ * Removes every packet recorded by the given \a tracker
+ */
+void DS_LossTrackerReset(DS_LossTracker *tracker)
+{
+   assert(tracker);
+   memset(tracker, 0, sizeof(DS_LossTracker));
+}
+
+/**
+ * Makes the given \a tracker start tracking the sequence numbers again from
+ * the next packet (e.g. because the sender changed), the recorded statistics
+ * are kept
+ */
+void DS_LossTrackerResync(DS_LossTracker *tracker)
+{
+   assert(tracker);
+   tracker->initialized = 0;
+}
+
+/**
+ * Returns the percentage of packets that were not received (or not received
+ * yet) during the last \a seconds, up to \c DS_LOSS_PERIODS seconds
+ *
+ * \param tracker the tracker to query
+ * \param now the current time (in ns, see \c DS_GetMonotonicTime())
+ * \param seconds the length of the history to use
+ */
+double DS_LossTrackerLoss(const DS_LossTracker *tracker, const uint64_t now, const int seconds)
+{
+   /* Check arguments */
+   assert(tracker);
+
+   /* Add the packets of the last seconds */
+   int i;
+   uint64_t expected = 0;
+   uint64_t arrived = 0;
+   uint64_t second = now / 1000000000;
+   for (i = 0; i < DS_LOSS_PERIODS; ++i)
+   {
+      if (tracker->period[i] <= second && second - tracker->period[i] < (uint64_t)seconds)
+      {
+         expected += tracker->expected[i];
+         arrived += tracker->arrived[i];
+      }
+   }
+
+   /* Nothing was expected, so nothing was lost */
+   if (expected == 0 || arrived >= expected)
+      return 0;
+
+   return (1 - ((double)arrived / (double)expected)) * 100;
+}
+
+/**
+ * Records the arrival of the packet with the given \a sequence number, at the
+ * given \a time (in ns). This function runs in constant time and does not
+ * allocate memory.
+ *
+ * \returns whether the packet arrived in order, late or was a duplicate
+ */
+DS_PacketOrder DS_LossTrackerRecord(DS_LossTracker *tracker, const uint16_t sequence, const uint64_t time)
+{
+   /* Check arguments */
+   assert(tracker);
+
+   /* Get the distance to the highest sequence number (handles wrap-around) */
+   int slot = history_slot(tracker, time);
+   int delta = (int16_t)(uint16_t)(sequence - tracker->highest);
+
+   /* First packet, or the sender was restarted */
+   if (!tracker->initialized || delta > DS_LOSS_RESYNC || delta < -DS_LOSS_RESYNC)
+   {
+      synchronize(tracker, sequence);
+      ++tracker->received;
+      ++tracker->expected[slot];
+      ++tracker->arrived[slot];
+      return DS_PACKET_IN_ORDER;
+   }
+
+   /* Same packet as the highest one */
+   if (delta == 0)
+   {
+      ++tracker->duplicates;
+      return DS_PACKET_DUPLICATE;
+   }
+
+   /* Newer packet, move the window (and count the packets that leave it) */
+   if (delta > 0)
+   {
+      uint64_t valid = (tracker->filled >= 64) ? ~0ULL : ((1ULL << tracker->filled) - 1);
+
+      if (delta >= 64)
+      {
+         tracker->lost += tracker->filled - count_bits(tracker->window) + (delta - 64);
+         tracker->window = 1;
+         tracker->filled = 64;
+      }
+
+      else
+      {
+         uint64_t leaving = (~0ULL << (64 - delta)) & valid;
+         tracker->lost += count_bits(leaving) - count_bits(tracker->window & leaving);
+         tracker->window = (tracker->window << delta) | 1;
+         tracker->filled = (tracker->filled + delta > 64) ? 64 : tracker->filled + delta;
+      }
+
+      tracker->highest = sequence;
+      tracker->expected[slot] += delta;
+      ++tracker->arrived[slot];
+      ++tracker->received;
+      return DS_PACKET_IN_ORDER;
+   }
+
+   /* Older packet that is still in the window */
+   if (-delta < tracker->filled)
+   {
+      uint64_t bit = 1ULL << -delta;
+      if (tracker->window & bit)
+      {
+         ++tracker->duplicates;
+         return DS_PACKET_DUPLICATE;
+      }
+
+      tracker->window |= bit;
+      ++tracker->arrived[slot];
+      ++tracker->received;
+      ++tracker->late;
+      return DS_PACKET_LATE;
+   }
+
+   /* Packet is too old (it was already counted as lost) */
+   ++tracker->late;
+   return DS_PACKET_LATE;
+}
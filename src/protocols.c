@@ -1,636 +1,1700 @@
-/*
- * The Driver Station Library (LibDS)
- * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
- *
- * Permission is hereby granted, free of charge, to any person obtaining
- * a copy of this software and associated documentation files (the "Software"),
- * to deal in the Software without restriction, including without limitation
- * the rights to use, copy, modify, merge, publish, distribute, sublicense,
- * and/or sell copies of the Software, and to permit persons to whom the
- * Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
- * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-
-#include "DS_Utils.h"
-#include "DS_Timer.h"
-#include "DS_Client.h"
-#include "DS_Config.h"
-#include "DS_Events.h"
-#include "DS_Socket.h"
-#include "DS_Protocol.h"
-
-#include <stdio.h>
-#include <assert.h>
-#include <stdlib.h>
-#include <string.h>
-#include <pthread.h>
-
-#define SEND_PRECISION 1 /* Update the sender timers every millisecond */
-#define RECV_PRECISION 50 /* Update the watchdogs every 50 milliseconds */
-
-/*
- * Protocol data
- */
-static DS_Protocol protocol;
-static int enable_operations = 0;
-
-/*
- * Define the sender watchdogs (when one expires, we send a packet)
- */
-static DS_Timer fms_send_timer;
-static DS_Timer radio_send_timer;
-static DS_Timer robot_send_timer;
-
-/*
- * Define the receiver watchdogs (when one expires, comms are lost)
- */
-static DS_Timer fms_recv_timer;
-static DS_Timer radio_recv_timer;
-static DS_Timer robot_recv_timer;
-
-/*
- * If set to anything else than 0, then the event loop will be allowed to run
- */
-static int running = 0;
-
-/*
- * Protocol read success booleans (used to feed the watchdogs)
- */
-static int fms_read = 0;
-static int radio_read = 0;
-static int robot_read = 0;
-
-/*
- * Holds the received data
- */
-static DS_String fms_data;
-static DS_String radio_data;
-static DS_String robot_data;
-static DS_String netcs_data;
-
-/*
- * Holds the sent/received packets
- */
-static int sent_fms_packets = 0;
-static int sent_radio_packets = 0;
-static int sent_robot_packets = 0;
-static int received_fms_packets = 0;
-static int received_radio_packets = 0;
-static int received_robot_packets = 0;
-
-/*
- * Sent/received bytes
- */
-static unsigned long sent_fms_bytes = 0;
-static unsigned long recv_fms_bytes = 0;
-static unsigned long sent_radio_bytes = 0;
-static unsigned long recv_radio_bytes = 0;
-static unsigned long sent_robot_bytes = 0;
-static unsigned long recv_robot_bytes = 0;
-
-/*
- * The thread ID for the protocol event loop
- */
-static pthread_t event_thread;
-
-/**
- * Sends a new packet to the FMS, the generated data is immediatly deleted
- * once the packet has been sent
- */
-static void send_fms_data()
-{
-   if (enable_operations)
-   {
-      ++sent_fms_packets;
-      DS_String data = protocol.create_fms_packet();
-      sent_fms_bytes += DS_Max(DS_SocketSend(&protocol.fms_socket, &data), 0);
-      DS_StrRmBuf(&data);
-   }
-}
-
-/**
- * Sends a new packet to the radio, the generated data is immediatly deleted
- * once the packet has been sent
- */
-static void send_radio_data()
-{
-   if (enable_operations)
-   {
-      ++sent_radio_packets;
-      DS_String data = protocol.create_radio_packet();
-      sent_radio_bytes += DS_Max(DS_SocketSend(&protocol.radio_socket, &data), 0);
-      DS_StrRmBuf(&data);
-   }
-}
-
-/**
- * Sends a new packet to the robot, the generated data is immediatly deleted
- * once the packet has been sent
- */
-static void send_robot_data()
-{
-   if (enable_operations)
-   {
-      ++sent_robot_packets;
-      DS_String data = protocol.create_robot_packet();
-      sent_robot_bytes += DS_Max(DS_SocketSend(&protocol.robot_socket, &data), 0);
-      DS_StrRmBuf(&data);
-   }
-}
-
-/**
- * Sends data over the network using the functions of the current protocol.
- * If there is no protocol running, then this function will do nothing.
- */
-static void send_data()
-{
-   /* Protocol is NULL, abort */
-   if (!enable_operations)
-      return;
-
-   /* Send FMS packet */
-   if (fms_send_timer.expired)
-   {
-      send_fms_data();
-      DS_TimerReset(&fms_send_timer);
-   }
-
-   /* Send radio packet */
-   if (radio_send_timer.expired)
-   {
-      send_radio_data();
-      DS_TimerReset(&radio_send_timer);
-   }
-
-   /* Send robot packet */
-   if (robot_send_timer.expired)
-   {
-      send_robot_data();
-      DS_TimerReset(&robot_send_timer);
-   }
-}
-
-/**
- * Clears the strings that hold the incoming data packets
- */
-static void clear_recv_data()
-{
-   DS_StrRmBuf(&fms_data);
-   DS_StrRmBuf(&radio_data);
-   DS_StrRmBuf(&robot_data);
-   DS_StrRmBuf(&netcs_data);
-}
-
-/**
- * Reads the received data using the functions provided by the current protocol.
- * If there is no protocol running, then this function will do nothing.
- */
-static void recv_data()
-{
-   /* Protocol is NULL, abort */
-   if (!enable_operations)
-      return;
-
-   /* Clear buffers (just to be sure) */
-   clear_recv_data();
-
-   /* Read data from sockets */
-   fms_data = DS_SocketRead(&protocol.fms_socket);
-   radio_data = DS_SocketRead(&protocol.radio_socket);
-   robot_data = DS_SocketRead(&protocol.robot_socket);
-   netcs_data = DS_SocketRead(&protocol.netconsole_socket);
-
-   /* Update received data indicators */
-   recv_fms_bytes += DS_StrLen(&fms_data);
-   recv_radio_bytes += DS_StrLen(&radio_data);
-   recv_robot_bytes += DS_StrLen(&robot_data);
-
-   /* Read FMS packet */
-   if (DS_StrLen(&fms_data) > 0)
-   {
-      ++received_fms_packets;
-      fms_read = protocol.read_fms_packet(&fms_data);
-      CFG_SetFMSCommunications(fms_read);
-   }
-
-   /* Read radio packet */
-   if (DS_StrLen(&radio_data) > 0)
-   {
-      ++received_radio_packets;
-      radio_read = protocol.read_radio_packet(&radio_data);
-      CFG_SetRadioCommunications(radio_read);
-   }
-
-   /* Read robot packet */
-   if (DS_StrLen(&robot_data) > 0)
-   {
-      ++received_robot_packets;
-      robot_read = protocol.read_robot_packet(&robot_data);
-      CFG_SetRobotCommunications(robot_read);
-   }
-
-   /* Add NetConsole message to event system */
-   if (netcs_data.len > 0)
-      CFG_AddNetConsoleMessage(&netcs_data);
-
-   /* Reset the data pointers */
-   clear_recv_data();
-}
-
-/**
- * Feeds the watchdogs, updates them and checks if any of them has expired
- */
-static void update_watchdogs()
-{
-   /* Feed the watchdogs if packets are read */
-   if (fms_read)
-      DS_TimerReset(&fms_recv_timer);
-   if (radio_read)
-      DS_TimerReset(&radio_recv_timer);
-   if (robot_read)
-      DS_TimerReset(&robot_recv_timer);
-
-   /* Clear the read success values */
-   fms_read = 0;
-   radio_read = 0;
-   robot_read = 0;
-
-   /* Reset the FMS if the watchdog expires */
-   if (fms_recv_timer.expired)
-   {
-      CFG_FMSWatchdogExpired();
-      DS_TimerReset(&fms_recv_timer);
-   }
-
-   /* Reset the radio if the watchdog expires */
-   if (radio_recv_timer.expired)
-   {
-      CFG_RadioWatchdogExpired();
-      DS_TimerReset(&radio_recv_timer);
-   }
-
-   /* Reset the robot if the watchdog expires */
-   if (robot_recv_timer.expired)
-   {
-      CFG_RobotWatchdogExpired();
-      DS_TimerReset(&robot_recv_timer);
-   }
-}
-
-/**
- * This function is executed periodically, the function does the following:
- *    - Send data to the FMS, robot and radio
- *    - Read received data from the FMS, robot and radio
- *    - Feed/reset the watchdogs
- *    - Check if any of the watchdogs has expired
- */
-static void *run_event_loop()
-{
-   while (running)
-   {
-      send_data();
-      recv_data();
-      update_watchdogs();
-      DS_Sleep(5);
-   }
-
-   return NULL;
-}
-
-/**
- * Returns a pointer to the current protocol
- */
-DS_Protocol *DS_CurrentProtocol()
-{
-   if (enable_operations)
-      return &protocol;
-
-   return NULL;
-}
-
-/**
- * Initializes the protocol sender/receiver thread and the timers
- */
-void Protocols_Init()
-{
-   /* Initialize sender timers */
-   DS_TimerInit(&fms_send_timer, 0, SEND_PRECISION);
-   DS_TimerInit(&radio_send_timer, 0, SEND_PRECISION);
-   DS_TimerInit(&robot_send_timer, 0, SEND_PRECISION);
-
-   /* Initialize watchdog timers */
-   DS_TimerInit(&fms_recv_timer, 0, RECV_PRECISION);
-   DS_TimerInit(&radio_recv_timer, 0, RECV_PRECISION);
-   DS_TimerInit(&robot_recv_timer, 0, RECV_PRECISION);
-
-   /* Allow the event loop to run */
-   running = 1;
-   enable_operations = 0;
-
-   /* Configure the event thread */
-   int error = pthread_create(&event_thread, NULL, &run_event_loop, NULL);
-
-   /* Display error message if we cannot star the event loop */
-   if (error)
-   {
-      DS_String caption = DS_StrNew("LibDS");
-      DS_String message = DS_StrNew("Cannot start protocol event loop!");
-      DS_ShowMessageBox(&caption, &message, DS_ICON_ERROR);
-      DS_StrRmBuf(&caption);
-      DS_StrRmBuf(&message);
-   }
-
-   /* Quit if the thread fails to start */
-   assert(!error);
-}
-
-/**
- * De-allocates the current protocol and closes its sockets
- */
-static void close_protocol()
-{
-   /* Protocol is empty, abort */
-   if (!enable_operations)
-      return;
-
-   /* Disable protocol operations */
-   enable_operations = 0;
-
-   /* Stop sender timers */
-   DS_TimerStop(&fms_send_timer);
-   DS_TimerStop(&radio_send_timer);
-   DS_TimerStop(&robot_send_timer);
-
-   /* Stop receiver timers */
-   DS_TimerStop(&fms_recv_timer);
-   DS_TimerStop(&radio_recv_timer);
-   DS_TimerStop(&robot_recv_timer);
-
-   /* Close the sockets */
-   DS_SocketClose(&protocol.fms_socket);
-   DS_SocketClose(&protocol.radio_socket);
-   DS_SocketClose(&protocol.robot_socket);
-   DS_SocketClose(&protocol.netconsole_socket);
-
-   /* Reset sent/recv bytes */
-   sent_fms_bytes = 0;
-   recv_fms_bytes = 0;
-   sent_radio_bytes = 0;
-   recv_radio_bytes = 0;
-   sent_robot_bytes = 0;
-   recv_robot_bytes = 0;
-
-   /* Reset sent/recv packets */
-   DS_ResetFMSPackets();
-   DS_ResetRadioPackets();
-   DS_ResetRobotPackets();
-
-   /* Create notification string */
-   char *name = DS_StrToChar(&protocol.name);
-   DS_String str = DS_StrFormat("Closed %s protocol", name);
-   CFG_AddNotification(&str);
-   DS_StrRmBuf(&str);
-   DS_FREE(name);
-}
-
-/**
- * Stops the sender/receiver thread and deletes the allocated protocol
- */
-void Protocols_Close()
-{
-   running = 0;
-   close_protocol();
-   clear_recv_data();
-}
-
-/**
- * De-allocates the current protocol and loads the given protocol
- *
- * Note the given \a ptr is not used directly, you should free it
- * after using it...
- *
- * \param ptr pointer to the new protocol implementation to load
- */
-void DS_ConfigureProtocol(const DS_Protocol *ptr)
-{
-   /* Pointer is NULL, abort */
-   assert(ptr != NULL);
-
-   /* Close previous protocol */
-   close_protocol();
-
-   /* Re-assign the protocol */
-   protocol = *ptr;
-
-   /* Update sockets */
-   DS_SocketOpen(&protocol.fms_socket);
-   DS_SocketOpen(&protocol.radio_socket);
-   DS_SocketOpen(&protocol.robot_socket);
-   DS_SocketOpen(&protocol.netconsole_socket);
-
-   /* Update sender timers */
-   fms_send_timer.time = protocol.fms_interval;
-   radio_send_timer.time = protocol.radio_interval;
-   robot_send_timer.time = protocol.robot_interval;
-
-   /* Update watchdogs */
-   fms_recv_timer.time = DS_Min(protocol.fms_interval * 50, 1000);
-   radio_recv_timer.time = DS_Min(protocol.radio_interval * 50, 1000);
-   robot_recv_timer.time = DS_Min(protocol.robot_interval * 50, 1000);
-
-   /* Start the timers */
-   DS_TimerStart(&fms_send_timer);
-   DS_TimerStart(&fms_recv_timer);
-   DS_TimerStart(&radio_send_timer);
-   DS_TimerStart(&radio_recv_timer);
-   DS_TimerStart(&robot_send_timer);
-   DS_TimerStart(&robot_recv_timer);
-
-   /* Create notification string */
-   char *name = DS_StrToChar(&protocol.name);
-   DS_String str = DS_StrFormat("Loaded %s protocol", name);
-   CFG_AddNotification(&str);
-   DS_StrRmBuf(&str);
-   DS_FREE(name);
-
-   /* Restore protocol operations */
-   enable_operations = 1;
-}
-
-/**
- * Returns the number of sent FMS bytes since the current
- * protocol was loaded.
- *
- * This value is only reset to 0 when the current protocol
- * is closed (e.g while loading another protocol).
- */
-unsigned long DS_SentFMSBytes()
-{
-   return sent_fms_bytes;
-}
-
-/**
- * Returns the number of sent radio bytes since the current
- * protocol was loaded.
- *
- * This value is only reset to 0 when the current protocol
- * is closed (e.g while loading another protocol).
- */
-unsigned long DS_SentRadioBytes()
-{
-   return sent_radio_bytes;
-}
-
-/**
- * Returns the number of sent robot bytes since the current
- * protocol was loaded.
- *
- * This value is only reset to 0 when the current protocol
- * is closed (e.g while loading another protocol).
- */
-unsigned long DS_SentRobotBytes()
-{
-   return sent_robot_bytes;
-}
-
-/**
- * Returns the number of received FMS bytes since the
- * current protocol was loaded.
- *
- * This value is only reset to 0 when the current protocol
- * is closed (e.g while loading another protocol).
- */
-unsigned long DS_ReceivedFMSBytes()
-{
-   return recv_fms_bytes;
-}
-
-/**
- * Returns the number of received radio bytes since the
- * current protocol was loaded.
- *
- * This value is only reset to 0 when the current protocol
- * is closed (e.g while loading another protocol).
- */
-unsigned long DS_ReceivedRadioBytes()
-{
-   return recv_radio_bytes;
-}
-
-/**
- * Returns the number of received robot bytes since the
- * current protocol was loaded.
- *
- * This value is only reset to 0 when the current protocol
- * is closed (e.g while loading another protocol).
- */
-unsigned long DS_ReceivedRobotBytes()
-{
-   return recv_robot_bytes;
-}
-
-/**
- * Returns the number of sent FMS packets.
- *
- * This value is reset when the communications with
- * the FMS are changed, or when the protocol is changed.
- */
-int DS_SentFMSPackets()
-{
-   return DS_Max(1, sent_fms_packets);
-}
-
-/**
- * Returns the number of sent radio packets.
- *
- * This value is reset when the communications with
- * the radio are changed, or when the protocol is changed.
- */
-int DS_SentRadioPackets()
-{
-   return DS_Max(1, sent_radio_packets);
-}
-
-/**
- * Returns the number of sent robot packets.
- *
- * This value is reset when the communications with
- * the robot are changed, or when the protocol is changed.
- */
-int DS_SentRobotPackets()
-{
-   return DS_Max(1, sent_robot_packets);
-}
-
-/**
- * Returns the number of received FMS packets.
- *
- * This value is reset when the communications with
- * the FMS are changed, or when the protocol is changed.
- */
-int DS_ReceivedFMSPackets()
-{
-   return received_fms_packets;
-}
-
-/**
- * Returns the number of received radio packets.
- *
- * This value is reset when the communications with
- * the radio are changed, or when the protocol is changed.
- */
-int DS_ReceivedRadioPackets()
-{
-   return received_radio_packets;
-}
-
-/**
- * Returns the number of received robot packets.
- *
- * This value is reset when the communications with
- * the robot are changed, or when the protocol is changed.
- */
-int DS_ReceivedRobotPackets()
-{
-   return received_robot_packets;
-}
-
-/**
- * Resets the number of sent/received FMS packets.
- * This function is called when the connection state with the FMS is changed
- */
-void DS_ResetFMSPackets()
-{
-   sent_fms_packets = 0;
-   received_fms_packets = 0;
-}
-
-/**
- * Resets the number of sent/received radio packets.
- * This function is called when the connection state with the radio is changed
- */
-void DS_ResetRadioPackets()
-{
-   sent_radio_packets = 0;
-   received_radio_packets = 0;
-}
-
-/**
- * Resets the number of sent/received robot packets.
- * This function is called when the connection state with the robot is changed
- */
-void DS_ResetRobotPackets()
-{
-   sent_robot_packets = 0;
-   received_robot_packets = 0;
-}
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "DS_Utils.h"
+#include "DS_Timer.h"
+#include "DS_Client.h"
+#include "DS_Config.h"
+#include "DS_Context.h"
+#include "DS_Atomic.h"
+#include "DS_Events.h"
+#include "DS_Socket.h"
+#include "DS_Protocol.h"
+#include "DS_Histogram.h"
+#include "DS_LossTracker.h"
+
+#include <time.h>
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define NO_DEADLINE UINT64_MAX /* The deadline is never reached */
+#define ECHO_RING_SIZE 64 /* Number of robot packets that wait for an echo */
+#define MS_TO_NS(ms) ((uint64_t)(ms) * 1000000) /* Converts ms to ns */
+
+/*
+ * Holds the state of the protocol module of a context, each context runs its
+ * own protocol and event loop
+ */
+typedef struct _protocols
+{
+   /*
+    * Protocol data
+    */
+   DS_Protocol protocol;
+   int enable_operations;
+
+   /*
+    * Held by the event loop while it operates on the protocol, while the
+    * protocol is being replaced or closed, and by the other threads while
+    * they call the protocol functions (see Protocols_Lock()). The lock is
+    * recursive, because the protocol functions call the client functions
+    */
+   pthread_mutex_t protocol_lock;
+
+   /*
+    * Absolute send deadlines (in ns, see DS_GetMonotonicTime()), when one is
+    * reached, we send a packet
+    */
+   uint64_t fms_send_time;
+   uint64_t radio_send_time;
+   uint64_t robot_send_time;
+
+   /*
+    * Absolute watchdog deadlines (when one is reached, comms are lost)
+    */
+   uint64_t fms_watchdog;
+   uint64_t radio_watchdog;
+   uint64_t robot_watchdog;
+
+   /*
+    * If set to anything else than 0, then the event loop will be allowed to run
+    */
+   int running;
+
+   /*
+    * Used to wake the event loop before its next deadline (e.g. when a socket
+    * receives new data)
+    */
+   int wakeup_pending;
+   pthread_cond_t wakeup_cond;
+   pthread_mutex_t wakeup_lock;
+
+   /*
+    * Packet loss of each link (indexed by DS_Link), detected with the sequence
+    * numbers of the received packets. A link is reported as lossy when its loss
+    * reaches the threshold, and as healthy when it falls below half of it
+    */
+   int loss_window;
+   double loss_threshold;
+   int loss_high[3];
+   unsigned int reset_loss;
+   DS_LossTracker loss_trackers[3];
+
+   /*
+    * Holds the sent/received packets and bytes. The counters are modified by one
+    * thread at a time (see statistics_lock) and read without locks by the other
+    * threads, \c statistics_sequence is odd while the counters are modified
+    */
+   DS_Statistics statistics;
+   unsigned int statistics_sequence;
+   pthread_mutex_t statistics_lock;
+
+   /*
+    * Arrival time of the last received packets
+    */
+   uint64_t fms_time;
+   uint64_t radio_time;
+   uint64_t robot_time;
+
+   /*
+    * Held by the protocol thread while it modifies the measurements below
+    * (and the packet loss trackers above), and by the other threads while
+    * they copy them or change the loss settings
+    */
+   pthread_mutex_t measurement_lock;
+
+   /*
+    * Send cadence of each link (indexed by DS_Link), the histograms are only
+    * modified by the protocol thread, other threads request a reset instead
+    */
+   unsigned int reset_statistics;
+   uint64_t last_send_time[3];
+   DS_Histogram send_intervals[3];
+   DS_Histogram send_lateness[3];
+
+   /*
+    * Round-trip time to the robot, the send time of each robot packet is stored
+    * in a ring (indexed by its sequence number) until the robot echoes it
+    */
+   int robot_sequence;
+   unsigned int reset_trip_time;
+   uint64_t trip_time_last;
+   uint64_t trip_time_ewma;
+   DS_Histogram trip_times;
+   int echo_sequence[ECHO_RING_SIZE];
+   uint64_t echo_time[ECHO_RING_SIZE];
+
+   /*
+    * Time between the arrival of each packet and the moment in which the
+    * protocol finished reading it (indexed by DS_Link)
+    */
+   unsigned int reset_latency;
+   uint64_t latency_last[3];
+   DS_Histogram receive_latency[3];
+
+   /*
+    * The thread ID for the protocol event loop
+    */
+   pthread_t event_thread;
+} Protocols;
+
+/**
+ * Returns the protocol state of the current context
+ */
+static Protocols *protocols(void)
+{
+   return (Protocols *)DS_GetContextData(DS_MODULE_PROTOCOLS);
+}
+
+/**
+ * Marks the traffic counters as being modified, readers will wait (or retry)
+ * until \c end_update() is called
+ */
+static void begin_update()
+{
+   Protocols *p = protocols();
+
+   pthread_mutex_lock(&p->statistics_lock);
+   DS_AtomicStore(&p->statistics_sequence, p->statistics_sequence + 1);
+   DS_AtomicFence();
+}
+
+/**
+ * Publishes the changes made to the traffic counters
+ */
+static void end_update()
+{
+   Protocols *p = protocols();
+
+   DS_AtomicStore(&p->statistics_sequence, p->statistics_sequence + 1);
+   pthread_mutex_unlock(&p->statistics_lock);
+}
+
+/**
+ * Adds the given \a value to the given traffic \a counter
+ *
+ * \note Call this function between \c begin_update() and \c end_update()
+ */
+static void add_to_counter(uint64_t *counter, const uint64_t value)
+{
+   DS_AtomicStore64(counter, *counter + value);
+}
+
+/**
+ * Queues a new packet to the FMS, the packet is sent (together with the
+ * other due packets) when \c send_data() flushes the transmit queue
+ */
+static void send_fms_data()
+{
+   Protocols *p = protocols();
+
+   if (p->enable_operations)
+   {
+      DS_String data = p->protocol.create_fms_packet();
+      int bytes = DS_SocketQueue(&p->protocol.fms_socket, &data);
+      DS_StrRmBuf(&data);
+
+      begin_update();
+      add_to_counter(&p->statistics.sent_fms_packets, 1);
+      add_to_counter(&p->statistics.sent_fms_bytes, DS_Max(bytes, 0));
+      end_update();
+   }
+}
+
+/**
+ * Queues a new packet to the radio, the packet is sent (together with the
+ * other due packets) when \c send_data() flushes the transmit queue
+ */
+static void send_radio_data()
+{
+   Protocols *p = protocols();
+
+   if (p->enable_operations)
+   {
+      DS_String data = p->protocol.create_radio_packet();
+      int bytes = DS_SocketQueue(&p->protocol.radio_socket, &data);
+      DS_StrRmBuf(&data);
+
+      begin_update();
+      add_to_counter(&p->statistics.sent_radio_packets, 1);
+      add_to_counter(&p->statistics.sent_radio_bytes, DS_Max(bytes, 0));
+      end_update();
+   }
+}
+
+/**
+ * Queues a new packet to the robot, the packet is sent (together with the
+ * other due packets) when \c send_data() flushes the transmit queue.
+ *
+ * Protocols that implement \c update_robot_packet() keep a persistent packet
+ * and only patch the fields that changed since the last packet, the function
+ * points the given view to that packet (which we must not delete). Otherwise,
+ * a new packet is created with \c create_robot_packet().
+ */
+static void send_robot_data()
+{
+   Protocols *p = protocols();
+
+   if (p->enable_operations)
+   {
+      /* Patch the persistent packet of the protocol (or create a new one) */
+      DS_String data;
+      if (p->protocol.update_robot_packet)
+         p->protocol.update_robot_packet(&data);
+      else
+         data = p->protocol.create_robot_packet();
+
+      /* Get the sequence number of the packet (to measure the trip time) */
+      if (p->protocol.robot_echoes_sequence && DS_StrLen(&data) >= 2)
+         p->robot_sequence = ((uint8_t)DS_StrCharAt(&data, 0) << 8) | (uint8_t)DS_StrCharAt(&data, 1);
+      int bytes = DS_SocketQueue(&p->protocol.robot_socket, &data);
+
+      /* Only delete packets that belong to us */
+      if (!p->protocol.update_robot_packet)
+         DS_StrRmBuf(&data);
+
+      begin_update();
+      add_to_counter(&p->statistics.sent_robot_packets, 1);
+      add_to_counter(&p->statistics.sent_robot_bytes, DS_Max(bytes, 0));
+      end_update();
+   }
+}
+
+/**
+ * Returns the send deadline that follows the given \a deadline.
+ *
+ * The deadlines are multiples of the \a interval (counted from the first
+ * deadline), so that packets do not drift over time. If the loop falls behind,
+ * the missed packets are skipped instead of being sent in a burst.
+ *
+ * \param deadline the deadline that was reached
+ * \param interval the send interval of the link (in milliseconds)
+ * \param now the current time (in nanoseconds)
+ */
+static uint64_t next_send_time(const uint64_t deadline, const int interval, const uint64_t now)
+{
+   /* Link does not send packets */
+   if (interval <= 0 || deadline == NO_DEADLINE)
+      return NO_DEADLINE;
+
+   /* Skip every period that already passed */
+   uint64_t period = MS_TO_NS(interval);
+   if (now < deadline)
+      return deadline + period;
+
+   return deadline + ((now - deadline) / period + 1) * period;
+}
+
+/**
+ * Returns the time at which the watchdog of a link with the given
+ * \a interval expires, if no packets are received until then.
+ *
+ * \param interval the send interval of the link (in milliseconds)
+ * \param now the current time (in nanoseconds)
+ */
+static uint64_t watchdog_time(const int interval, const uint64_t now)
+{
+   /* Link does not send packets, so it has no watchdog */
+   if (interval <= 0)
+      return NO_DEADLINE;
+
+   return now + MS_TO_NS(DS_Min(interval * 50, 1000));
+}
+
+/**
+ * Records the send cadence of the given \a link, after a packet that was
+ * scheduled for \a deadline was sent at the given \a time
+ */
+static void record_send(const DS_Link link, const uint64_t deadline, const uint64_t time)
+{
+   Protocols *p = protocols();
+
+   pthread_mutex_lock(&p->measurement_lock);
+
+   /* Record the time since the previous packet */
+   if (p->last_send_time[link] > 0)
+      DS_HistogramRecord(&p->send_intervals[link], time - p->last_send_time[link]);
+
+   /* Record the delay relative to the deadline */
+   DS_HistogramRecord(&p->send_lateness[link], time - deadline);
+   p->last_send_time[link] = time;
+
+   pthread_mutex_unlock(&p->measurement_lock);
+}
+
+/**
+ * Sends data over the network using the functions of the current protocol.
+ * If there is no protocol running, then this function will do nothing.
+ *
+ * \param now the current time (in nanoseconds)
+ */
+static void send_data(const uint64_t now)
+{
+   Protocols *p = protocols();
+
+   /* Protocol is NULL, abort */
+   if (!p->enable_operations)
+      return;
+
+   /* Clear the send cadence statistics if requested */
+   if (DS_AtomicLoad(&p->reset_statistics))
+   {
+      int i;
+      pthread_mutex_lock(&p->measurement_lock);
+      for (i = 0; i < 3; ++i)
+      {
+         p->last_send_time[i] = 0;
+         DS_HistogramReset(&p->send_intervals[i]);
+         DS_HistogramReset(&p->send_lateness[i]);
+      }
+      pthread_mutex_unlock(&p->measurement_lock);
+
+      DS_AtomicStore(&p->reset_statistics, 0);
+   }
+
+   /* Get the deadlines that were reached */
+   uint64_t fms_deadline = p->fms_send_time;
+   uint64_t radio_deadline = p->radio_send_time;
+   uint64_t robot_deadline = p->robot_send_time;
+
+   /* Send FMS packet */
+   if (now >= fms_deadline)
+   {
+      send_fms_data();
+      p->fms_send_time = next_send_time(fms_deadline, p->protocol.fms_interval, now);
+   }
+
+   /* Send radio packet */
+   if (now >= radio_deadline)
+   {
+      send_radio_data();
+      p->radio_send_time = next_send_time(radio_deadline, p->protocol.radio_interval, now);
+   }
+
+   /* Send robot packet */
+   if (now >= robot_deadline)
+   {
+      send_robot_data();
+      p->robot_send_time = next_send_time(robot_deadline, p->protocol.robot_interval, now);
+   }
+
+   /* Send every queued packet at once */
+   uint64_t time = DS_GetMonotonicTime();
+   DS_SocketFlush();
+
+   /* Record the time at which the packets were sent */
+   if (now >= DS_Min(fms_deadline, DS_Min(radio_deadline, robot_deadline)))
+   {
+      if (now >= fms_deadline)
+         record_send(DS_LINK_FMS, fms_deadline, time);
+      if (now >= radio_deadline)
+         record_send(DS_LINK_RADIO, radio_deadline, time);
+      if (now >= robot_deadline)
+         record_send(DS_LINK_ROBOT, robot_deadline, time);
+
+      /* Wait for the robot to echo the packet */
+      if (p->robot_sequence >= 0)
+      {
+         p->echo_sequence[p->robot_sequence % ECHO_RING_SIZE] = p->robot_sequence;
+         p->echo_time[p->robot_sequence % ECHO_RING_SIZE] = time;
+         p->robot_sequence = -1;
+      }
+   }
+}
+
+/**
+ * Measures the round-trip time of the robot packet whose sequence number is
+ * echoed by the given robot \a packet, which was received at \a time
+ */
+static void record_trip_time(const DS_String *packet, const uint64_t time)
+{
+   Protocols *p = protocols();
+
+   /* Packet has no sequence number */
+   if (DS_StrLen(packet) < 2)
+      return;
+
+   /* Find the send time of the echoed packet */
+   int sequence = ((uint8_t)DS_StrCharAt(packet, 0) << 8) | (uint8_t)DS_StrCharAt(packet, 1);
+   int slot = sequence % ECHO_RING_SIZE;
+
+   /* Packet is unknown, too old or was already echoed */
+   if (p->echo_sequence[slot] != sequence || p->echo_time[slot] == 0 || time < p->echo_time[slot])
+      return;
+
+   /* Record the round-trip time */
+   uint64_t trip_time = time - p->echo_time[slot];
+   p->echo_time[slot] = 0;
+   pthread_mutex_lock(&p->measurement_lock);
+   DS_HistogramRecord(&p->trip_times, trip_time);
+
+   /* Update the moving average */
+   p->trip_time_last = trip_time;
+   if (p->trip_time_ewma == 0)
+      p->trip_time_ewma = trip_time;
+   else
+      p->trip_time_ewma = (p->trip_time_ewma * 7 + trip_time) / 8;
+
+   pthread_mutex_unlock(&p->measurement_lock);
+}
+
+/**
+ * Records the time elapsed since the given packet of the given \a link arrived
+ * at \a time, this is called after the protocol has read the packet
+ */
+static void record_latency(const DS_Link link, const uint64_t time)
+{
+   Protocols *p = protocols();
+
+   uint64_t now = DS_GetMonotonicTime();
+
+   /* Arrival time is unknown (or from a clock that is ahead of ours) */
+   if (time == 0 || now < time)
+      return;
+
+   pthread_mutex_lock(&p->measurement_lock);
+   p->latency_last[link] = now - time;
+   DS_HistogramRecord(&p->receive_latency[link], now - time);
+   pthread_mutex_unlock(&p->measurement_lock);
+}
+
+/**
+ * Records the sequence number (first two bytes) of the given \a packet, which
+ * was received from the given \a link at the given \a time, and notifies the
+ * client when the loss of the link crosses the threshold
+ */
+static void track_loss(const DS_Link link, const DS_String *packet, const uint64_t time)
+{
+   Protocols *p = protocols();
+
+   /* Packet has no sequence number */
+   if (DS_StrLen(packet) < 2)
+      return;
+
+   /* Record the sequence number */
+   uint16_t sequence = (uint16_t)(((uint8_t)DS_StrCharAt(packet, 0) << 8) | (uint8_t)DS_StrCharAt(packet, 1));
+   pthread_mutex_lock(&p->measurement_lock);
+   DS_LossTrackerRecord(&p->loss_trackers[link], sequence, time);
+
+   /* Check if the loss crossed the threshold */
+   int changed = 0;
+   int high = p->loss_high[link];
+   double loss = DS_LossTrackerLoss(&p->loss_trackers[link], time, p->loss_window);
+   if (!high && loss >= p->loss_threshold)
+      high = 1;
+   else if (high && loss < p->loss_threshold / 2)
+      high = 0;
+
+   if (high != p->loss_high[link])
+   {
+      p->loss_high[link] = high;
+      changed = 1;
+   }
+   pthread_mutex_unlock(&p->measurement_lock);
+
+   /* Notify the client */
+   if (changed)
+   {
+      DS_Event event;
+      event.loss.type = DS_PACKET_LOSS_CHANGED;
+      event.loss.link = link;
+      event.loss.high = high;
+      event.loss.loss = (float)loss;
+      DS_AddEvent(&event);
+   }
+}
+
+/**
+ * Reads the received data using the functions provided by the current protocol.
+ * If there is no protocol running, then this function will do nothing.
+ *
+ * This is called as soon as the sockets module reports new data, so packets
+ * are parsed when they arrive and the watchdogs are fed with their arrival
+ * time (instead of waiting for the next send or watchdog deadline).
+ *
+ * The received packets are not copied, the protocol functions receive a view
+ * of the socket's receive buffer, which is released at the end of the tick.
+ */
+static void recv_data()
+{
+   Protocols *p = protocols();
+
+   /* Protocol is NULL, abort */
+   if (!p->enable_operations)
+      return;
+
+   /* Clear the trip time statistics if requested */
+   if (DS_AtomicLoad(&p->reset_trip_time))
+   {
+      pthread_mutex_lock(&p->measurement_lock);
+      p->trip_time_last = 0;
+      p->trip_time_ewma = 0;
+      DS_HistogramReset(&p->trip_times);
+      pthread_mutex_unlock(&p->measurement_lock);
+
+      memset(p->echo_time, 0, sizeof(p->echo_time));
+      DS_AtomicStore(&p->reset_trip_time, 0);
+   }
+
+   /* Clear the packet loss statistics if requested */
+   if (DS_AtomicLoad(&p->reset_loss))
+   {
+      int i;
+      pthread_mutex_lock(&p->measurement_lock);
+      for (i = 0; i < 3; ++i)
+      {
+         p->loss_high[i] = 0;
+         DS_LossTrackerReset(&p->loss_trackers[i]);
+      }
+      pthread_mutex_unlock(&p->measurement_lock);
+
+      DS_AtomicStore(&p->reset_loss, 0);
+   }
+
+   /* Clear the receive latency statistics if requested */
+   if (DS_AtomicLoad(&p->reset_latency))
+   {
+      int i;
+      pthread_mutex_lock(&p->measurement_lock);
+      for (i = 0; i < 3; ++i)
+      {
+         p->latency_last[i] = 0;
+         DS_HistogramReset(&p->receive_latency[i]);
+      }
+      pthread_mutex_unlock(&p->measurement_lock);
+
+      DS_AtomicStore(&p->reset_latency, 0);
+   }
+
+   /* Initialize the packet view */
+   DS_String packet;
+
+   /* Read every FMS packet */
+   while (DS_SocketBorrow(&p->protocol.fms_socket, &packet, &p->fms_time))
+   {
+      begin_update();
+      add_to_counter(&p->statistics.received_fms_packets, 1);
+      add_to_counter(&p->statistics.received_fms_bytes, DS_StrLen(&packet));
+      end_update();
+
+      int read = p->protocol.read_fms_packet(&packet);
+      CFG_SetFMSCommunications(read);
+      record_latency(DS_LINK_FMS, p->fms_time);
+
+      if (read)
+         p->fms_watchdog = watchdog_time(p->protocol.fms_interval, p->fms_time);
+
+      if (read && p->protocol.fms_sends_sequence)
+         track_loss(DS_LINK_FMS, &packet, p->fms_time);
+   }
+
+   /* Read every radio packet */
+   while (DS_SocketBorrow(&p->protocol.radio_socket, &packet, &p->radio_time))
+   {
+      begin_update();
+      add_to_counter(&p->statistics.received_radio_packets, 1);
+      add_to_counter(&p->statistics.received_radio_bytes, DS_StrLen(&packet));
+      end_update();
+
+      int read = p->protocol.read_radio_packet(&packet);
+      CFG_SetRadioCommunications(read);
+      record_latency(DS_LINK_RADIO, p->radio_time);
+
+      if (read)
+         p->radio_watchdog = watchdog_time(p->protocol.radio_interval, p->radio_time);
+   }
+
+   /* Read every robot packet */
+   while (DS_SocketBorrow(&p->protocol.robot_socket, &packet, &p->robot_time))
+   {
+      begin_update();
+      add_to_counter(&p->statistics.received_robot_packets, 1);
+      add_to_counter(&p->statistics.received_robot_bytes, DS_StrLen(&packet));
+      end_update();
+
+      int read = p->protocol.read_robot_packet(&packet);
+      CFG_SetRobotCommunications(read);
+      record_latency(DS_LINK_ROBOT, p->robot_time);
+
+      if (read)
+         p->robot_watchdog = watchdog_time(p->protocol.robot_interval, p->robot_time);
+
+      if (read && p->protocol.robot_echoes_sequence)
+      {
+         record_trip_time(&packet, p->robot_time);
+         track_loss(DS_LINK_ROBOT, &packet, p->robot_time);
+      }
+   }
+
+   /* Add every NetConsole message to event system */
+   while (DS_SocketBorrow(&p->protocol.netconsole_socket, &packet, NULL))
+      CFG_AddNetConsoleMessage(&packet);
+
+   /* Release the received packets */
+   DS_SocketRelease(&p->protocol.fms_socket);
+   DS_SocketRelease(&p->protocol.radio_socket);
+   DS_SocketRelease(&p->protocol.robot_socket);
+   DS_SocketRelease(&p->protocol.netconsole_socket);
+}
+
+/**
+ * Feeds the watchdogs, updates them and checks if any of them has expired
+ *
+ * \param now the current time (in nanoseconds)
+ */
+static void update_watchdogs(const uint64_t now)
+{
+   Protocols *p = protocols();
+
+   /* Protocol is NULL, abort */
+   if (!p->enable_operations)
+      return;
+
+   /* Reset the FMS if the watchdog expires */
+   if (now >= p->fms_watchdog)
+   {
+      CFG_FMSWatchdogExpired();
+      p->fms_watchdog = watchdog_time(p->protocol.fms_interval, now);
+   }
+
+   /* Reset the radio if the watchdog expires */
+   if (now >= p->radio_watchdog)
+   {
+      CFG_RadioWatchdogExpired();
+      p->radio_watchdog = watchdog_time(p->protocol.radio_interval, now);
+   }
+
+   /* Reset the robot if the watchdog expires */
+   if (now >= p->robot_watchdog)
+   {
+      CFG_RobotWatchdogExpired();
+      p->robot_watchdog = watchdog_time(p->protocol.robot_interval, now);
+   }
+}
+
+/**
+ * Returns the nearest send or watchdog deadline
+ */
+static uint64_t next_deadline()
+{
+   Protocols *p = protocols();
+
+   /* There is nothing to do until a protocol is loaded */
+   if (!p->enable_operations)
+      return NO_DEADLINE;
+
+   /* Get the nearest send deadline */
+   uint64_t deadline = DS_Min(p->fms_send_time, p->radio_send_time);
+   deadline = DS_Min(deadline, p->robot_send_time);
+
+   /* Get the nearest watchdog deadline */
+   deadline = DS_Min(deadline, p->fms_watchdog);
+   deadline = DS_Min(deadline, p->radio_watchdog);
+   deadline = DS_Min(deadline, p->robot_watchdog);
+
+   return deadline;
+}
+
+/**
+ * Wakes the event loop of the given protocol state before its next deadline
+ */
+static void wake_event_loop(Protocols *p)
+{
+   pthread_mutex_lock(&p->wakeup_lock);
+   p->wakeup_pending = 1;
+   pthread_cond_signal(&p->wakeup_cond);
+   pthread_mutex_unlock(&p->wakeup_lock);
+}
+
+/**
+ * Called by the sockets module when a socket receives new data, the sockets
+ * of each protocol point to the state of the context that owns them
+ */
+static void on_socket_ready(DS_Socket *ptr)
+{
+   if (ptr->user_data)
+      wake_event_loop((Protocols *)ptr->user_data);
+}
+
+/**
+ * Blocks the event loop until the given absolute \a deadline is reached
+ * (see \c DS_GetMonotonicTime()), or until the loop is woken up by the
+ * arrival of new data
+ */
+static void wait_until(const uint64_t deadline)
+{
+   Protocols *p = protocols();
+
+   pthread_mutex_lock(&p->wakeup_lock);
+   while (p->running && !p->wakeup_pending)
+   {
+      /* Wait for new data */
+      if (deadline == NO_DEADLINE)
+         pthread_cond_wait(&p->wakeup_cond, &p->wakeup_lock);
+
+      /* Wait for new data or for the deadline */
+      else
+      {
+         if (DS_GetMonotonicTime() >= deadline)
+            break;
+
+         if (DS_CondWaitUntil(&p->wakeup_cond, &p->wakeup_lock, deadline) == ETIMEDOUT)
+            break;
+      }
+   }
+
+   p->wakeup_pending = 0;
+   pthread_mutex_unlock(&p->wakeup_lock);
+}
+
+/**
+ * This function is executed by the protocol thread, the function does the
+ * following:
+ *    - Send data to the FMS, robot and radio (when their deadlines are reached)
+ *    - Read received data from the FMS, robot and radio
+ *    - Feed/reset the watchdogs
+ *    - Check if any of the watchdogs has expired
+ *    - Sleep until the next deadline, or until new data is received
+ */
+static void *run_event_loop(void *context)
+{
+   /* Operate on the context that started the thread */
+   DS_SetCurrentContext((DS_Context *)context);
+   Protocols *p = protocols();
+
+   while (p->running)
+   {
+      uint64_t now = DS_GetMonotonicTime();
+
+      pthread_mutex_lock(&p->protocol_lock);
+      send_data(now);
+      recv_data();
+      update_watchdogs(now);
+      uint64_t deadline = next_deadline();
+      pthread_mutex_unlock(&p->protocol_lock);
+
+      wait_until(deadline);
+   }
+
+   return NULL;
+}
+
+/**
+ * Returns a pointer to the current protocol.
+ *
+ * \note The protocol may be replaced by \c DS_ConfigureProtocol() at any
+ *       time, so threads other than the event loop must hold the lock of
+ *       \c Protocols_Lock() while they use the returned pointer
+ */
+DS_Protocol *DS_CurrentProtocol()
+{
+   Protocols *p = protocols();
+
+   if (p && p->enable_operations)
+      return &p->protocol;
+
+   return NULL;
+}
+
+/**
+ * Prevents the protocol of the current context from being replaced or closed,
+ * and waits for its event loop to finish its current iteration. Hold the lock
+ * while using \c DS_CurrentProtocol() (or calling the protocol functions)
+ * from a thread other than the event loop.
+ *
+ * \note The lock is recursive, every call must be matched by a call to
+ *       \c Protocols_Unlock()
+ */
+void Protocols_Lock()
+{
+   pthread_mutex_lock(&protocols()->protocol_lock);
+}
+
+/**
+ * Releases the lock obtained with \c Protocols_Lock()
+ */
+void Protocols_Unlock()
+{
+   pthread_mutex_unlock(&protocols()->protocol_lock);
+}
+
+/**
+ * Allocates the protocol state of the current context and starts its
+ * sender/receiver thread
+ */
+void Protocols_Init()
+{
+   /* Allocate the protocol state */
+   Protocols *p = (Protocols *)calloc(1, sizeof(Protocols));
+   p->fms_send_time = NO_DEADLINE;
+   p->radio_send_time = NO_DEADLINE;
+   p->robot_send_time = NO_DEADLINE;
+   p->fms_watchdog = NO_DEADLINE;
+   p->radio_watchdog = NO_DEADLINE;
+   p->robot_watchdog = NO_DEADLINE;
+   p->loss_window = 5;
+   p->loss_threshold = 10;
+   p->robot_sequence = -1;
+   pthread_mutex_init(&p->wakeup_lock, NULL);
+   pthread_mutex_init(&p->statistics_lock, NULL);
+   pthread_mutex_init(&p->measurement_lock, NULL);
+   DS_SetContextData(DS_MODULE_PROTOCOLS, p);
+
+   /* Initialize the protocol lock (it is recursive, see Protocols_Lock()) */
+   pthread_mutexattr_t attributes;
+   pthread_mutexattr_init(&attributes);
+   pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+   pthread_mutex_init(&p->protocol_lock, &attributes);
+   pthread_mutexattr_destroy(&attributes);
+
+   /* Initialize the wakeup condition (using the monotonic clock) */
+   DS_CondInit(&p->wakeup_cond);
+
+   /* Allow the event loop to run */
+   p->running = 1;
+   p->wakeup_pending = 0;
+   p->enable_operations = 0;
+
+   /* Wake the event loops when new data is received */
+   DS_SocketSetReadyCallback(&on_socket_ready);
+
+   /* Configure the event thread */
+   int error = pthread_create(&p->event_thread, NULL, &run_event_loop, DS_CurrentContext());
+
+   /* Display error message if we cannot star the event loop */
+   if (error)
+   {
+      DS_String caption = DS_StrNew("LibDS");
+      DS_String message = DS_StrNew("Cannot start protocol event loop!");
+      DS_ShowMessageBox(&caption, &message, DS_ICON_ERROR);
+      DS_StrRmBuf(&caption);
+      DS_StrRmBuf(&message);
+   }
+
+   /* Quit if the thread fails to start */
+   assert(!error);
+}
+
+/**
+ * Deletes the state of the protocol implementation with the function given
+ * by the protocol. The library does not know how the state was allocated, so
+ * the state is left alone if the protocol gives no function.
+ */
+static void free_private_data(Protocols *p)
+{
+   if (p->protocol.free_private_data)
+      p->protocol.free_private_data(p->protocol.private_data);
+
+   p->protocol.private_data = NULL;
+}
+
+/**
+ * De-allocates the current protocol and closes its sockets
+ */
+static void close_protocol()
+{
+   Protocols *p = protocols();
+
+   /* Protocol is empty, abort */
+   if (!p->enable_operations)
+      return;
+
+   /* Disable protocol operations */
+   p->enable_operations = 0;
+
+   /* Clear the send deadlines */
+   p->fms_send_time = NO_DEADLINE;
+   p->radio_send_time = NO_DEADLINE;
+   p->robot_send_time = NO_DEADLINE;
+
+   /* Clear the watchdog deadlines */
+   p->fms_watchdog = NO_DEADLINE;
+   p->radio_watchdog = NO_DEADLINE;
+   p->robot_watchdog = NO_DEADLINE;
+
+   /* Clear the send cadence and trip time statistics */
+   DS_ResetSendStatistics();
+   DS_ResetRobotTripTime();
+   DS_ResetLossStatistics();
+   DS_ResetReceiveLatency();
+
+   /* Close the sockets */
+   DS_SocketClose(&p->protocol.fms_socket);
+   DS_SocketClose(&p->protocol.radio_socket);
+   DS_SocketClose(&p->protocol.robot_socket);
+   DS_SocketClose(&p->protocol.netconsole_socket);
+
+   /* Delete the state of the protocol implementation */
+   free_private_data(p);
+
+   /* Reset sent/recv bytes */
+   begin_update();
+   DS_AtomicStore64(&p->statistics.sent_fms_bytes, 0);
+   DS_AtomicStore64(&p->statistics.sent_radio_bytes, 0);
+   DS_AtomicStore64(&p->statistics.sent_robot_bytes, 0);
+   DS_AtomicStore64(&p->statistics.received_fms_bytes, 0);
+   DS_AtomicStore64(&p->statistics.received_radio_bytes, 0);
+   DS_AtomicStore64(&p->statistics.received_robot_bytes, 0);
+   end_update();
+
+   /* Reset sent/recv packets */
+   DS_ResetFMSPackets();
+   DS_ResetRadioPackets();
+   DS_ResetRobotPackets();
+
+   /* Create notification string */
+   char *name = DS_StrToChar(&p->protocol.name);
+   DS_String str = DS_StrFormat("Closed %s protocol", name);
+   CFG_AddNotification(&str);
+   DS_StrRmBuf(&str);
+   DS_FREE(name);
+}
+
+/**
+ * Stops the sender/receiver thread and deletes the allocated protocol
+ */
+void Protocols_Close()
+{
+   Protocols *p = protocols();
+
+   /* Stop the event loop */
+   pthread_mutex_lock(&p->wakeup_lock);
+   p->running = 0;
+   pthread_cond_signal(&p->wakeup_cond);
+   pthread_mutex_unlock(&p->wakeup_lock);
+   pthread_join(p->event_thread, NULL);
+
+   /* Close the current protocol */
+   close_protocol();
+
+   /* Free the protocol state */
+   pthread_cond_destroy(&p->wakeup_cond);
+   pthread_mutex_destroy(&p->protocol_lock);
+   pthread_mutex_destroy(&p->wakeup_lock);
+   pthread_mutex_destroy(&p->statistics_lock);
+   pthread_mutex_destroy(&p->measurement_lock);
+   DS_SetContextData(DS_MODULE_PROTOCOLS, NULL);
+   free(p);
+}
+
+/**
+ * Returns \c 1 if the given sockets have the same ports and options, in which
+ * case an open socket can be used by the new protocol
+ */
+static int same_socket(const DS_Socket *a, const DS_Socket *b)
+{
+   return a->type == b->type && a->transport == b->transport && a->in_port == b->in_port
+          && a->out_port == b->out_port && a->disabled == b->disabled && a->broadcast == b->broadcast
+          && a->timestamps == b->timestamps && a->backoff_min == b->backoff_min && a->backoff_max == b->backoff_max
+          && a->backoff_jitter == b->backoff_jitter;
+}
+
+/**
+ * Replaces the given \a socket with the given \a replacement. When \a reuse
+ * is set and both sockets have the same ports and options, the open socket is
+ * kept instead.
+ *
+ * \returns \c 1 if the socket was kept, \c 0 if it was replaced
+ */
+static int replace_socket(Protocols *p, DS_Socket *socket, const DS_Socket *replacement, const int reuse)
+{
+   /* The socket does not change, keep it open */
+   if (reuse && same_socket(socket, replacement))
+      return 1;
+
+   /* Close the current socket */
+   if (reuse)
+      DS_SocketClose(socket);
+
+   /* Open the new socket (and let it wake the event loop of this context) */
+   *socket = *replacement;
+   socket->user_data = p;
+   DS_SocketOpen(socket);
+   return 0;
+}
+
+/**
+ * Applies the given \a address to the given \a socket (if it is different
+ * from its current address) and deletes the \a address string
+ */
+static void apply_address(DS_Socket *socket, char *address)
+{
+   if (address && strncmp(socket->address, address, sizeof(socket->address)) != 0)
+      DS_SocketChangeAddress(socket, address);
+
+   DS_FREE(address);
+}
+
+/**
+ * Schedules the packets of a link after loading a protocol. The send deadline
+ * is kept unless the send \a interval changed, and the watchdog is kept unless
+ * the socket of the link was replaced.
+ */
+static void schedule_link(uint64_t *send_time, uint64_t *watchdog, const int interval, const int previous_interval,
+                          const int kept, const uint64_t now)
+{
+   if (!kept || interval != previous_interval)
+      *send_time = next_send_time(now, interval, now);
+
+   if (!kept)
+      *watchdog = watchdog_time(interval, now);
+}
+
+/**
+ * Returns an empty protocol for safe initialization, every function pointer,
+ * setting and socket is set to zero
+ */
+DS_Protocol DS_ProtocolEmpty(void)
+{
+   DS_Protocol protocol;
+   memset(&protocol, 0, sizeof(protocol));
+   return protocol;
+}
+
+/**
+ * Loads the given protocol, replacing the current protocol (if any).
+ *
+ * Sockets whose ports and options do not change are kept open, and the
+ * deadlines, watchdogs and counters of their links keep running, so that
+ * switching between similar protocols (e.g. FRC 2016 and FRC 2020) does not
+ * interrupt the communications. The event loop waits while the protocol is
+ * being replaced.
+ *
+ * Note the given \a ptr is not used directly, you should free it
+ * after using it...
+ *
+ * \param ptr pointer to the new protocol implementation to load
+ */
+void DS_ConfigureProtocol(const DS_Protocol *ptr)
+{
+   Protocols *p = protocols();
+
+   /* Pointer is NULL, abort */
+   assert(ptr != NULL);
+
+   /* Wait for the event loop to finish its current iteration */
+   pthread_mutex_lock(&p->protocol_lock);
+
+   /* Get the intervals of the previous protocol */
+   int reuse = p->enable_operations;
+   int fms_interval = p->protocol.fms_interval;
+   int radio_interval = p->protocol.radio_interval;
+   int robot_interval = p->protocol.robot_interval;
+
+   /* Delete the state of the previous protocol */
+   if (reuse)
+   {
+      char *name = DS_StrToChar(&p->protocol.name);
+      DS_String str = DS_StrFormat("Closed %s protocol", name);
+      CFG_AddNotification(&str);
+      DS_StrRmBuf(&str);
+      DS_FREE(name);
+
+      free_private_data(p);
+   }
+
+   /* Re-assign the protocol, except its sockets (the last members) */
+   p->enable_operations = 0;
+   memcpy(&p->protocol, ptr, offsetof(DS_Protocol, fms_socket));
+
+   /* Replace the sockets that change */
+   int fms = replace_socket(p, &p->protocol.fms_socket, &ptr->fms_socket, reuse);
+   int radio = replace_socket(p, &p->protocol.radio_socket, &ptr->radio_socket, reuse);
+   int robot = replace_socket(p, &p->protocol.robot_socket, &ptr->robot_socket, reuse);
+   replace_socket(p, &p->protocol.netconsole_socket, &ptr->netconsole_socket, reuse);
+
+   /* The new protocol numbers its packets from the start */
+   pthread_mutex_lock(&p->measurement_lock);
+   DS_LossTrackerResync(&p->loss_trackers[DS_LINK_FMS]);
+   DS_LossTrackerResync(&p->loss_trackers[DS_LINK_ROBOT]);
+   pthread_mutex_unlock(&p->measurement_lock);
+   memset(p->echo_time, 0, sizeof(p->echo_time));
+
+   /* Schedule the packets of each link */
+   uint64_t now = DS_GetMonotonicTime();
+   schedule_link(&p->fms_send_time, &p->fms_watchdog, p->protocol.fms_interval, fms_interval, fms, now);
+   schedule_link(&p->radio_send_time, &p->radio_watchdog, p->protocol.radio_interval, radio_interval, radio, now);
+   schedule_link(&p->robot_send_time, &p->robot_watchdog, p->protocol.robot_interval, robot_interval, robot, now);
+
+   /* Create notification string */
+   char *name = DS_StrToChar(&p->protocol.name);
+   DS_String str = DS_StrFormat("Loaded %s protocol", name);
+   CFG_AddNotification(&str);
+   DS_StrRmBuf(&str);
+   DS_FREE(name);
+
+   /* Restore protocol operations */
+   p->enable_operations = 1;
+
+   /* Use the addresses of the new protocol */
+   apply_address(&p->protocol.fms_socket, DS_GetAppliedFMSAddress());
+   apply_address(&p->protocol.radio_socket, DS_GetAppliedRadioAddress());
+   apply_address(&p->protocol.robot_socket, DS_GetAppliedRobotAddress());
+
+   pthread_mutex_unlock(&p->protocol_lock);
+   wake_event_loop(p);
+}
+
+/**
+ * Applies the given real-time \a options to the protocol event loop of the
+ * current context and to the socket thread (which is shared by all the
+ * contexts), and locks the memory of the process if requested.
+ *
+ * This is optional, by default the threads of the LibDS use the normal
+ * scheduling policy of the operating system. Real-time priorities usually
+ * require elevated permissions (e.g. \c CAP_SYS_NICE or \c RLIMIT_RTPRIO on
+ * Linux), when they are missing the threads keep their current settings (or
+ * use the highest priority allowed by \c RLIMIT_RTPRIO).
+ *
+ * \note Locking the memory also locks the stacks of the threads created
+ *       afterwards, which may prevent creating new contexts if the
+ *       \c RLIMIT_MEMLOCK of the process is low
+ *
+ * \returns the settings that were applied to all the threads, as a
+ *          combination of \c DS_REALTIME_SCHEDULING, \c DS_REALTIME_AFFINITY
+ *          and \c DS_REALTIME_MEMORY_LOCK
+ */
+int DS_SetRealtimeOptions(const DS_RealtimeOptions *options)
+{
+   assert(options);
+
+   /* Apply the options to the event loop and the socket thread */
+   int applied = DS_SetThreadOptions(protocols()->event_thread, options);
+   applied &= Sockets_SetRealtimeOptions(options);
+
+   /* Lock the memory of the process */
+   if (options->lock_memory && DS_LockMemory())
+      applied |= DS_REALTIME_MEMORY_LOCK;
+
+   return applied;
+}
+
+/**
+ * Returns the number of sent FMS bytes since the first
+ * protocol was loaded.
+ *
+ * This value is kept when another protocol is loaded, it
+ * is only reset to 0 when the DS is closed.
+ */
+unsigned long DS_SentFMSBytes()
+{
+   return (unsigned long)DS_AtomicLoad64(&protocols()->statistics.sent_fms_bytes);
+}
+
+/**
+ * Returns the number of sent radio bytes since the first
+ * protocol was loaded.
+ *
+ * This value is kept when another protocol is loaded, it
+ * is only reset to 0 when the DS is closed.
+ */
+unsigned long DS_SentRadioBytes()
+{
+   return (unsigned long)DS_AtomicLoad64(&protocols()->statistics.sent_radio_bytes);
+}
+
+/**
+ * Returns the number of sent robot bytes since the first
+ * protocol was loaded.
+ *
+ * This value is kept when another protocol is loaded, it
+ * is only reset to 0 when the DS is closed.
+ */
+unsigned long DS_SentRobotBytes()
+{
+   return (unsigned long)DS_AtomicLoad64(&protocols()->statistics.sent_robot_bytes);
+}
+
+/**
+ * Returns the number of received FMS bytes since the
+ * first protocol was loaded.
+ *
+ * This value is kept when another protocol is loaded, it
+ * is only reset to 0 when the DS is closed.
+ */
+unsigned long DS_ReceivedFMSBytes()
+{
+   return (unsigned long)DS_AtomicLoad64(&protocols()->statistics.received_fms_bytes);
+}
+
+/**
+ * Returns the number of received radio bytes since the
+ * first protocol was loaded.
+ *
+ * This value is kept when another protocol is loaded, it
+ * is only reset to 0 when the DS is closed.
+ */
+unsigned long DS_ReceivedRadioBytes()
+{
+   return (unsigned long)DS_AtomicLoad64(&protocols()->statistics.received_radio_bytes);
+}
+
+/**
+ * Returns the number of received robot bytes since the
+ * first protocol was loaded.
+ *
+ * This value is kept when another protocol is loaded, it
+ * is only reset to 0 when the DS is closed.
+ */
+unsigned long DS_ReceivedRobotBytes()
+{
+   return (unsigned long)DS_AtomicLoad64(&protocols()->statistics.received_robot_bytes);
+}
+
+/**
+ * Returns the arrival time of the last packet received from the FMS (in ns,
+ * see \c DS_GetMonotonicTime()). When supported by the operating system,
+ * this is the time at which the kernel received the packet.
+ */
+uint64_t DS_LastFMSPacketTime()
+{
+   return protocols()->fms_time;
+}
+
+/**
+ * Returns the arrival time of the last packet received from the radio (in ns,
+ * see \c DS_GetMonotonicTime()). When supported by the operating system,
+ * this is the time at which the kernel received the packet.
+ */
+uint64_t DS_LastRadioPacketTime()
+{
+   return protocols()->radio_time;
+}
+
+/**
+ * Returns the arrival time of the last packet received from the robot (in ns,
+ * see \c DS_GetMonotonicTime()). When supported by the operating system,
+ * this is the time at which the kernel received the packet.
+ */
+uint64_t DS_LastRobotPacketTime()
+{
+   return protocols()->robot_time;
+}
+
+/**
+ * Returns the number of sent FMS packets.
+ *
+ * This value is reset when the communications with
+ * the FMS are changed (it is kept when
+ * another protocol is loaded).
+ */
+int DS_SentFMSPackets()
+{
+   Protocols *p = protocols();
+
+   int packets = (int)DS_AtomicLoad64(&p->statistics.sent_fms_packets);
+   return DS_Max(1, packets);
+}
+
+/**
+ * Returns the number of sent radio packets.
+ *
+ * This value is reset when the communications with
+ * the radio are changed (it is kept when
+ * another protocol is loaded).
+ */
+int DS_SentRadioPackets()
+{
+   Protocols *p = protocols();
+
+   int packets = (int)DS_AtomicLoad64(&p->statistics.sent_radio_packets);
+   return DS_Max(1, packets);
+}
+
+/**
+ * Returns the number of sent robot packets.
+ *
+ * This value is reset when the communications with
+ * the robot are changed (it is kept when
+ * another protocol is loaded).
+ */
+int DS_SentRobotPackets()
+{
+   Protocols *p = protocols();
+
+   int packets = (int)DS_AtomicLoad64(&p->statistics.sent_robot_packets);
+   return DS_Max(1, packets);
+}
+
+/**
+ * Returns the number of received FMS packets.
+ *
+ * This value is reset when the communications with
+ * the FMS are changed (it is kept when
+ * another protocol is loaded).
+ */
+int DS_ReceivedFMSPackets()
+{
+   return (int)DS_AtomicLoad64(&protocols()->statistics.received_fms_packets);
+}
+
+/**
+ * Returns the number of received radio packets.
+ *
+ * This value is reset when the communications with
+ * the radio are changed (it is kept when
+ * another protocol is loaded).
+ */
+int DS_ReceivedRadioPackets()
+{
+   return (int)DS_AtomicLoad64(&protocols()->statistics.received_radio_packets);
+}
+
+/**
+ * Returns the number of received robot packets.
+ *
+ * This value is reset when the communications with
+ * the robot are changed (it is kept when
+ * another protocol is loaded).
+ */
+int DS_ReceivedRobotPackets()
+{
+   return (int)DS_AtomicLoad64(&protocols()->statistics.received_robot_packets);
+}
+
+/**
+ * Resets the number of sent/received FMS packets.
+ * This function is called when the connection state with the FMS is changed
+ */
+void DS_ResetFMSPackets()
+{
+   Protocols *p = protocols();
+
+   begin_update();
+   DS_AtomicStore64(&p->statistics.sent_fms_packets, 0);
+   DS_AtomicStore64(&p->statistics.received_fms_packets, 0);
+   end_update();
+}
+
+/**
+ * Resets the number of sent/received radio packets.
+ * This function is called when the connection state with the radio is changed
+ */
+void DS_ResetRadioPackets()
+{
+   Protocols *p = protocols();
+
+   begin_update();
+   DS_AtomicStore64(&p->statistics.sent_radio_packets, 0);
+   DS_AtomicStore64(&p->statistics.received_radio_packets, 0);
+   end_update();
+}
+
+/**
+ * Resets the number of sent/received robot packets.
+ * This function is called when the connection state with the robot is changed
+ */
+void DS_ResetRobotPackets()
+{
+   Protocols *p = protocols();
+
+   begin_update();
+   DS_AtomicStore64(&p->statistics.sent_robot_packets, 0);
+   DS_AtomicStore64(&p->statistics.received_robot_packets, 0);
+   end_update();
+}
+
+/**
+ * Copies every traffic counter of the current protocol into the given
+ * structure. The copy is consistent (all counters are read at the same
+ * point in time) and it never blocks the protocol thread, so this function
+ * is a better choice than calling each getter function separately.
+ *
+ * \note Unlike \c DS_SentRobotPackets() and similar functions, the sent
+ *       packet counters are not rounded up to 1
+ *
+ * \param stats pointer to the structure in which to write the counters
+ */
+void DS_GetStatistics(DS_Statistics *stats)
+{
+   Protocols *p = protocols();
+
+   /* Check arguments */
+   assert(stats);
+
+   /* The structure only holds 64-bit counters */
+   size_t i;
+   size_t count = sizeof(DS_Statistics) / sizeof(uint64_t);
+   const uint64_t *source = (const uint64_t *)&p->statistics;
+   uint64_t *target = (uint64_t *)stats;
+
+   /* Copy the counters again if they were modified during the copy */
+   unsigned int sequence;
+   do
+   {
+      sequence = DS_AtomicLoad(&p->statistics_sequence);
+      for (i = 0; i < count; ++i)
+         target[i] = DS_AtomicLoad64(&source[i]);
+
+      DS_AtomicFence();
+   }
+   while ((sequence & 1) || sequence != DS_AtomicLoad(&p->statistics_sequence));
+}
+
+/**
+ * Clears the send cadence statistics of every link.
+ *
+ * The statistics are cleared by the protocol thread before it sends the next
+ * packet, so this function can be called from any thread.
+ */
+void DS_ResetSendStatistics()
+{
+   DS_AtomicStore(&protocols()->reset_statistics, 1);
+}
+
+/**
+ * Obtains the send cadence of the given \a link since the current protocol
+ * was loaded (or since \c DS_ResetSendStatistics() was called): the time
+ * between consecutive packets and the delay of each packet relative to its
+ * scheduled deadline. All times are in nanoseconds.
+ *
+ * The histograms of the link are copied while the protocol thread is not
+ * modifying them, and the statistics are calculated from the copy.
+ *
+ * \param link the link to query (FMS, radio or robot)
+ * \param stats pointer to the structure in which to write the statistics
+ */
+void DS_GetSendStatistics(const DS_Link link, DS_SendStatistics *stats)
+{
+   Protocols *p = protocols();
+
+   /* Check arguments */
+   assert(stats);
+   assert(link >= DS_LINK_FMS && link <= DS_LINK_ROBOT);
+
+   /* Copy the histograms of the link */
+   DS_Histogram interval;
+   DS_Histogram lateness;
+   pthread_mutex_lock(&p->measurement_lock);
+   interval = p->send_intervals[link];
+   lateness = p->send_lateness[link];
+   pthread_mutex_unlock(&p->measurement_lock);
+
+   /* Get the interval statistics */
+   stats->samples = lateness.count;
+   stats->interval_max = interval.max;
+   stats->interval_mean = DS_HistogramMean(&interval);
+   stats->interval_p50 = DS_HistogramPercentile(&interval, 50);
+   stats->interval_p99 = DS_HistogramPercentile(&interval, 99);
+   stats->interval_p999 = DS_HistogramPercentile(&interval, 99.9);
+
+   /* Get the lateness statistics */
+   stats->lateness_max = lateness.max;
+   stats->lateness_mean = DS_HistogramMean(&lateness);
+   stats->lateness_p50 = DS_HistogramPercentile(&lateness, 50);
+   stats->lateness_p99 = DS_HistogramPercentile(&lateness, 99);
+   stats->lateness_p999 = DS_HistogramPercentile(&lateness, 99.9);
+}
+
+/**
+ * Clears the round-trip time statistics of the robot.
+ *
+ * The statistics are cleared by the protocol thread before it reads the next
+ * packets, so this function can be called from any thread.
+ */
+void DS_ResetRobotTripTime()
+{
+   DS_AtomicStore(&protocols()->reset_trip_time, 1);
+}
+
+/**
+ * Obtains the round-trip time between the client and the robot since the
+ * current protocol was loaded (or since \c DS_ResetRobotTripTime() was
+ * called). All times are in nanoseconds.
+ *
+ * Each trip is measured from the moment a robot packet is sent until the
+ * reply that echoes its sequence number arrives. If the protocol does not
+ * support this, then every value is \c 0.
+ *
+ * \param stats pointer to the structure in which to write the statistics
+ */
+void DS_GetRobotTripTime(DS_TripTimeStatistics *stats)
+{
+   Protocols *p = protocols();
+
+   /* Check arguments */
+   assert(stats);
+
+   /* Copy the measurements */
+   DS_Histogram trip_times;
+   pthread_mutex_lock(&p->measurement_lock);
+   trip_times = p->trip_times;
+   stats->last = p->trip_time_last;
+   stats->ewma = p->trip_time_ewma;
+   pthread_mutex_unlock(&p->measurement_lock);
+
+   /* Get the statistics */
+   stats->samples = trip_times.count;
+   stats->min = trip_times.min;
+   stats->max = trip_times.max;
+   stats->mean = DS_HistogramMean(&trip_times);
+   stats->p50 = DS_HistogramPercentile(&trip_times, 50);
+   stats->p99 = DS_HistogramPercentile(&trip_times, 99);
+   stats->p999 = DS_HistogramPercentile(&trip_times, 99.9);
+}
+
+/**
+ * Returns the given \a percentile (from 0 to 100) of the round-trip time
+ * between the client and the robot, in nanoseconds
+ */
+uint64_t DS_RobotTripTimePercentile(const double percentile)
+{
+   Protocols *p = protocols();
+
+   /* Copy the histogram */
+   DS_Histogram trip_times;
+   pthread_mutex_lock(&p->measurement_lock);
+   trip_times = p->trip_times;
+   pthread_mutex_unlock(&p->measurement_lock);
+
+   return DS_HistogramPercentile(&trip_times, percentile);
+}
+
+/**
+ * Clears the packet loss statistics of every link.
+ *
+ * The statistics are cleared by the protocol thread before it reads the next
+ * packets, so this function can be called from any thread.
+ */
+void DS_ResetLossStatistics()
+{
+   DS_AtomicStore(&protocols()->reset_loss, 1);
+}
+
+/**
+ * Changes the number of \a seconds used to calculate the loss percentage of
+ * each link (by default, the loss of the last 5 seconds is used)
+ */
+void DS_SetLossWindow(const int seconds)
+{
+   Protocols *p = protocols();
+
+   pthread_mutex_lock(&p->measurement_lock);
+   p->loss_window = DS_Max(1, DS_Min(seconds, DS_LOSS_PERIODS));
+   pthread_mutex_unlock(&p->measurement_lock);
+}
+
+/**
+ * Changes the loss \a percent at which a \c DS_PACKET_LOSS_CHANGED event is
+ * generated (10% by default). Another event is generated when the loss falls
+ * below half of the threshold.
+ */
+void DS_SetLossThreshold(const double percent)
+{
+   Protocols *p = protocols();
+
+   pthread_mutex_lock(&p->measurement_lock);
+   p->loss_threshold = percent;
+   pthread_mutex_unlock(&p->measurement_lock);
+}
+
+/**
+ * Obtains the packet loss of the given \a link since the current protocol
+ * was loaded (or since \c DS_ResetLossStatistics() was called).
+ *
+ * Packets are tracked with their sequence numbers, so a packet is counted as
+ * lost once 64 newer packets have been received. The loss percentage also
+ * counts the packets that are missing from the last seconds.
+ *
+ * \note The radio packets have no sequence numbers, so they are not tracked
+ *
+ * \param link the link to query (FMS, radio or robot)
+ * \param stats pointer to the structure in which to write the statistics
+ */
+void DS_GetLossStatistics(const DS_Link link, DS_LossStatistics *stats)
+{
+   Protocols *p = protocols();
+
+   /* Check arguments */
+   assert(stats);
+   assert(link >= DS_LINK_FMS && link <= DS_LINK_ROBOT);
+
+   /* Copy the tracker of the link */
+   DS_LossTracker tracker;
+   pthread_mutex_lock(&p->measurement_lock);
+   tracker = p->loss_trackers[link];
+   stats->high = p->loss_high[link];
+   int window = p->loss_window;
+   pthread_mutex_unlock(&p->measurement_lock);
+
+   /* Get the statistics of the link */
+   stats->received = tracker.received;
+   stats->lost = tracker.lost;
+   stats->late = tracker.late;
+   stats->duplicates = tracker.duplicates;
+   stats->loss = DS_LossTrackerLoss(&tracker, DS_GetMonotonicTime(), window);
+}
+
+/**
+ * Clears the receive latency statistics of every link.
+ *
+ * The statistics are cleared by the protocol thread before it reads the next
+ * packets, so this function can be called from any thread.
+ */
+void DS_ResetReceiveLatency()
+{
+   DS_AtomicStore(&protocols()->reset_latency, 1);
+}
+
+/**
+ * Obtains the time (in nanoseconds) between the arrival of the packets of the
+ * given \a link and the moment in which the protocol finished reading them,
+ * since the current protocol was loaded (or since \c DS_ResetReceiveLatency()
+ * was called).
+ *
+ * The arrival time is taken from the kernel when the platform supports it,
+ * so this includes the time spent in the sockets module and the time needed
+ * to wake the protocol thread.
+ *
+ * \param link the link to query (FMS, radio or robot)
+ * \param stats pointer to the structure in which to write the statistics
+ */
+void DS_GetReceiveLatency(const DS_Link link, DS_LatencyStatistics *stats)
+{
+   Protocols *p = protocols();
+
+   /* Check arguments */
+   assert(stats);
+   assert(link >= DS_LINK_FMS && link <= DS_LINK_ROBOT);
+
+   /* Copy the histogram of the link */
+   DS_Histogram latency;
+   pthread_mutex_lock(&p->measurement_lock);
+   latency = p->receive_latency[link];
+   stats->last = p->latency_last[link];
+   pthread_mutex_unlock(&p->measurement_lock);
+
+   /* Get the statistics of the link */
+   stats->samples = latency.count;
+   stats->min = latency.min;
+   stats->max = latency.max;
+   stats->mean = DS_HistogramMean(&latency);
+   stats->p50 = DS_HistogramPercentile(&latency, 50);
+   stats->p99 = DS_HistogramPercentile(&latency, 99);
+   stats->p999 = DS_HistogramPercentile(&latency, 99.9);
+}
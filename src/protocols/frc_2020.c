@@ -27,6 +27,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 
 #include "DS_Utils.h"
 #include "DS_Config.h"
@@ -78,17 +79,31 @@ static const int max_disk_bytes = 512000000;
 static const int max_ram_bytes = 256000000;
 
 /*
- * Sent robot and FMS packet counters
+ * Packet counters and control code flags, each context (see DS_Context.h) has
+ * its own copy, which is stored in the private data of its protocol
  */
-static unsigned int send_time_data = 0;
-static unsigned int sent_fms_packets = 0;
-static unsigned int sent_robot_packets = 0;
+typedef struct _state
+{
+   unsigned int send_time_data; /**< Set when the robot requests the time */
+   unsigned int sent_fms_packets; /**< Used as FMS packet IDs */
+   unsigned int sent_robot_packets; /**< Used as robot packet IDs */
+   int reboot; /**< Set to 1 to reboot the roboRIO */
+   int restart_code; /**< Set to 1 to restart the robot code */
+   DS_String robot_packet; /**< Persistent robot packet, patched before sending it */
+   int joysticks_valid; /**< Set to 0 when the joystick data must be re-created */
+   int joysticks_enabled; /**< Robot enabled state when the joysticks were encoded */
+   int joystick_count; /**< Number of joysticks in the joystick data */
+   unsigned int joystick_layout; /**< Joystick layout version of the joystick data */
+   unsigned int *joystick_versions; /**< Version of each encoded joystick */
+} State;
 
-/*
- * Control code flags
+/**
+ * Returns the state of the protocol of the current context
  */
-static int reboot = 0;
-static int restart_code = 0;
+static State *state(void)
+{
+   return (State *)DS_CurrentProtocol()->private_data;
+}
 
 /**
  * Obtains the voltage float from the given \a upper and \a lower bytes
@@ -228,14 +243,16 @@ static uint8_t get_control_code(void)
  */
 static uint8_t get_request_code(void)
 {
+   State *st = state();
+
    uint8_t code = cRequestNormal;
 
    /* Robot has comms, check if we need to send additional flags */
    if (CFG_GetRobotCommunications())
    {
-      if (reboot)
+      if (st->reboot)
          code = cRequestReboot;
-      else if (restart_code)
+      else if (st->restart_code)
          code = cRequestRestartCode;
    }
 
@@ -363,48 +380,122 @@ static DS_String get_timezone_data(void)
 }
 
 /**
- * Constructs a joystick information structure for every attached joystick.
+ * Returns the number of bytes that the given \a joystick uses in the robot
+ * packet, which is used to find the joystick in the persistent packet.
+ *
+ * The size reported by \c get_joystick_size() counts one byte per button,
+ * but the buttons are always encoded with three bytes (count + 16 flags)
  */
-static DS_String get_joystick_data(void)
+static int get_joystick_bytes(const int joystick)
+{
+   return get_joystick_size(joystick) - (DS_GetJoystickNumButtons(joystick) + 1) + 3;
+}
+
+/**
+ * Writes the information structure of the given \a joystick at the given
+ * \a offset of the robot \a packet (which must be large enough)
+ */
+static void encode_joystick(DS_String *packet, const int offset, const int joystick)
 {
    /* Initialize the variables */
-   int i = 0;
    int j = 0;
-   DS_String data = DS_StrNewLen(0);
+   uint8_t *data = (uint8_t *)packet->buf + offset;
+
+   /* Add joystick header */
+   *data++ = get_joystick_size(joystick);
+   *data++ = cTagJoystick;
+
+   /* Add axis data */
+   *data++ = DS_GetJoystickNumAxes(joystick);
+   for (j = 0; j < DS_GetJoystickNumAxes(joystick); ++j)
+      *data++ = DS_FloatToByte(DS_GetJoystickAxis(joystick, j), 1);
+
+   /* Generate button data (the flags only have room for 16 buttons) */
+   uint16_t button_flags = 0;
+   for (j = 0; j < DS_Min(DS_GetJoystickNumButtons(joystick), 16); ++j)
+      button_flags += DS_GetJoystickButton(joystick, j) ? (1 << j) : 0;
+
+   /* Add button data */
+   *data++ = DS_GetJoystickNumButtons(joystick);
+   *data++ = (uint8_t)(button_flags >> 8);
+   *data++ = (uint8_t)(button_flags);
+
+   /* Add hat data */
+   *data++ = DS_GetJoystickNumHats(joystick);
+   for (j = 0; j < DS_GetJoystickNumHats(joystick); ++j)
+   {
+      int hat = DS_GetJoystickHat(joystick, j);
+      *data++ = (uint8_t)(hat >> 8);
+      *data++ = (uint8_t)(hat);
+   }
+}
+
+/**
+ * Changes the length of the persistent robot packet, the contents of the
+ * packet are lost if its length changes
+ */
+static void resize_packet(State *st, const int length)
+{
+   if (DS_StrLen(&st->robot_packet) != length)
+   {
+      DS_StrRmBuf(&st->robot_packet);
+      st->robot_packet = DS_StrNewLen(length);
+   }
+}
+
+/**
+ * Updates the joystick information structures of the persistent robot packet,
+ * which begin after the 6-byte header. Unlike the 2014 protocol, the 2015
+ * protocol only generates joystick data for the attached joysticks.
+ *
+ * The structures are only re-created when joysticks are added or removed,
+ * otherwise, only the joysticks that changed since the last packet are
+ * encoded again.
+ *
+ * \note The caller must hold \c Joysticks_Lock(), the packet is laid out
+ *       with the joystick sizes and they must not change until the
+ *       joysticks are encoded
+ */
+static void update_joystick_data(State *st)
+{
+   /* Initialize the variables */
+   int i = 0;
+   int offset = 6;
+   int rebuild = 0;
+   int count = DS_GetJoystickCount();
+   int enabled = CFG_GetRobotEnabled();
+   unsigned int layout = DS_GetJoystickLayoutVersion();
+
+   /* Joysticks were added or removed, re-create the joystick data */
+   if (!st->joysticks_valid || st->joystick_layout != layout || st->joystick_count != count)
+   {
+      int length = offset;
+      for (i = 0; i < count; ++i)
+         length += get_joystick_bytes(i);
+
+      resize_packet(st, length);
+      DS_FREE(st->joystick_versions);
+      st->joystick_versions = (unsigned int *)calloc(count + 1, sizeof(unsigned int));
+      st->joystick_count = count;
+      st->joystick_layout = layout;
+      st->joysticks_valid = 1;
+      rebuild = 1;
+   }
 
-   /* Generate data for each joystick */
-   for (i = 0; i < DS_GetJoystickCount(); ++i)
+   /* Encode the joysticks that changed (the getters depend on the enabled state) */
+   for (i = 0; i < count; ++i)
    {
-      DS_StrAppend(&data, get_joystick_size(i));
-      DS_StrAppend(&data, cTagJoystick);
-
-      /* Add axis data */
-      DS_StrAppend(&data, DS_GetJoystickNumAxes(i));
-      for (j = 0; j < DS_GetJoystickNumAxes(i); ++j)
-         DS_StrAppend(&data, DS_FloatToByte(DS_GetJoystickAxis(i, j), 1));
-
-      /* Generate button data */
-      uint16_t button_flags = 0;
-      for (j = 0; j < DS_GetJoystickNumButtons(i); ++j)
-         button_flags += DS_GetJoystickButton(i, j) ? (int)pow(2, j) : 0;
-
-      /* Add button data */
-      /* potential TODO: this assumes num_buttons <= 16 */
-      DS_StrAppend(&data, DS_GetJoystickNumButtons(i));
-      DS_StrAppend(&data, (uint8_t)(button_flags >> 8));
-      DS_StrAppend(&data, (uint8_t)(button_flags));
-
-      /* Add hat data */
-      DS_StrAppend(&data, DS_GetJoystickNumHats(i));
-      for (j = 0; j < DS_GetJoystickNumHats(i); ++j)
+      unsigned int version = DS_GetJoystickVersion(i);
+      if (rebuild || enabled != st->joysticks_enabled || version != st->joystick_versions[i])
       {
-         DS_StrAppend(&data, (uint8_t)(DS_GetJoystickHat(i, j) >> 8));
-         DS_StrAppend(&data, (uint8_t)(DS_GetJoystickHat(i, j)));
+         st->joystick_versions[i] = version;
+         encode_joystick(&st->robot_packet, offset, i);
       }
+
+      offset += get_joystick_bytes(i);
    }
 
-   /* Return obtained data */
-   return data;
+   st->joysticks_enabled = enabled;
 }
 
 /**
@@ -496,6 +587,8 @@ static DS_Position get_position(const uint8_t byte)
  */
 static DS_String create_fms_packet(void)
 {
+   State *st = state();
+
    /* Create an 8-byte long packet */
    DS_String data = DS_StrNewLen(8);
 
@@ -505,8 +598,8 @@ static DS_String create_fms_packet(void)
    encode_voltage(CFG_GetRobotVoltage(), &integer, &decimal);
 
    /* Add FMS packet count */
-   DS_StrSetChar(&data, 0, (sent_fms_packets >> 8));
-   DS_StrSetChar(&data, 1, (sent_fms_packets));
+   DS_StrSetChar(&data, 0, (st->sent_fms_packets >> 8));
+   DS_StrSetChar(&data, 1, (st->sent_fms_packets));
 
    /* Add DS version and FMS control code */
    DS_StrSetChar(&data, 2, cFMSCommVersion);
@@ -521,55 +614,79 @@ static DS_String create_fms_packet(void)
    DS_StrSetChar(&data, 7, decimal);
 
    /* Increase FMS packet counter */
-   ++sent_fms_packets;
+   ++st->sent_fms_packets;
 
    return data;
 }
 
 /**
- * Generates a packet that the DS will send to the robot, it contains the
- * following information:
+ * Updates the persistent packet that the DS sends to the robot and points the
+ * given \a view to it, the packet contains the following information:
  *    - Packet index / ID
  *    - Control code (control modes, e-stop state, etc)
  *    - Request code (robot reboot, restart code, normal operation, etc)
  *    - Team station (alliance & position)
  *    - Date and time data (if robot requests it)
  *    - Joystick information (if the robot does not want date/time)
+ *
+ * The view is valid until the next call to this function.
  */
-static DS_String create_robot_packet(void)
+static void update_robot_packet(DS_String *view)
 {
-   DS_String data = DS_StrNewLen(6);
+   State *st = state();
 
-   /* Add packet index */
-   DS_StrSetChar(&data, 0, (sent_robot_packets >> 8));
-   DS_StrSetChar(&data, 1, (sent_robot_packets));
-
-   /* Add packet header */
-   DS_StrSetChar(&data, 2, cTagCommVersion);
+   int length = 6;
 
-   /* Add control code, request flags and team station */
-   DS_StrSetChar(&data, 3, get_control_code());
-   DS_StrSetChar(&data, 4, get_request_code());
-   DS_StrSetChar(&data, 5, get_station_code());
-
-   /* Add timezone data (if robot wants it) */
-   if (send_time_data)
+   /* Add timezone data (if robot wants it), it replaces the joystick data */
+   if (st->send_time_data)
    {
       DS_String tz = get_timezone_data();
-      DS_StrJoin(&data, &tz);
+      length += DS_StrLen(&tz);
+      resize_packet(st, length);
+      memcpy(st->robot_packet.buf + 6, tz.buf, DS_StrLen(&tz));
+      st->joysticks_valid = 0;
+      DS_StrRmBuf(&tz);
    }
 
    /* Add joystick data */
-   else if (sent_robot_packets > 5)
+   else if (st->sent_robot_packets > 5)
    {
-      DS_String js = get_joystick_data();
-      DS_StrJoin(&data, &js);
+      Joysticks_Lock();
+      update_joystick_data(st);
+      Joysticks_Unlock();
+      length = DS_StrLen(&st->robot_packet);
    }
 
+   /* Add packet index */
+   uint8_t *data = (uint8_t *)st->robot_packet.buf;
+   data[0] = (uint8_t)(st->sent_robot_packets >> 8);
+   data[1] = (uint8_t)(st->sent_robot_packets);
+
+   /* Add packet header */
+   data[2] = cTagCommVersion;
+
+   /* Add control code, request flags and team station */
+   data[3] = get_control_code();
+   data[4] = get_request_code();
+   data[5] = get_station_code();
+
    /* Increase robot packet counter */
-   ++sent_robot_packets;
+   ++st->sent_robot_packets;
 
-   return data;
+   /* Point the view to the packet */
+   view->buf = st->robot_packet.buf;
+   view->len = length;
+}
+
+/**
+ * Generates a new packet that the DS will send to the robot (a copy of the
+ * persistent packet, see \c update_robot_packet())
+ */
+static DS_String create_robot_packet(void)
+{
+   DS_String view;
+   update_robot_packet(&view);
+   return DS_StrDup(&view);
 }
 
 /**
@@ -648,7 +765,7 @@ static int read_robot_packet(const DS_String *data)
    CFG_SetEmergencyStopped(control & cEmergencyStop);
 
    /* Update date/time request flag */
-   send_time_data = (request == cRequestTime);
+   state()->send_time_data = (request == cRequestTime);
 
    /* Calculate the voltage */
    uint8_t upper = (uint8_t)DS_StrCharAt(data, 5);
@@ -668,9 +785,11 @@ static int read_robot_packet(const DS_String *data)
  */
 static void reset_robot(void)
 {
-   reboot = 0;
-   restart_code = 0;
-   send_time_data = 0;
+   State *st = state();
+
+   st->reboot = 0;
+   st->restart_code = 0;
+   st->send_time_data = 0;
 }
 
 /**
@@ -678,7 +797,7 @@ static void reset_robot(void)
  */
 static void reboot_robot(void)
 {
-   reboot = 1;
+   state()->reboot = 1;
 }
 
 /**
@@ -687,7 +806,22 @@ static void reboot_robot(void)
  */
 static void restart_robot_code(void)
 {
-   restart_code = 1;
+   state()->restart_code = 1;
+}
+
+/**
+ * Deletes the given protocol state and the buffers that it owns
+ */
+static void free_state(void *data)
+{
+   State *st = (State *)data;
+
+   if (st)
+   {
+      DS_StrRmBuf(&st->robot_packet);
+      DS_FREE(st->joystick_versions);
+      free(st);
+   }
 }
 
 /**
@@ -697,9 +831,17 @@ DS_Protocol DS_GetProtocolFRC_2020(void)
 {
    DS_Protocol protocol = DS_GetProtocolFRC_2016();
 
+   /* Replace the state of the FRC 2016 protocol with our own */
+   protocol.free_private_data(protocol.private_data);
+   State *st = (State *)calloc(1, sizeof(State));
+   st->robot_packet = DS_StrNewLen(6);
+   protocol.private_data = st;
+   protocol.free_private_data = &free_state;
+
    /* Set packet generator functions */
    protocol.create_fms_packet = &create_fms_packet;
    protocol.create_robot_packet = &create_robot_packet;
+   protocol.update_robot_packet = &update_robot_packet;
 
    /* Set packet interpretation functions */
    protocol.read_fms_packet = &read_fms_packet;
@@ -1,378 +1,2356 @@
-/*
- * The Driver Station Library (LibDS)
- * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
- *
- * Permission is hereby granted, free of charge, to any person obtaining
- * a copy of this software and associated documentation files (the "Software"),
- * to deal in the Software without restriction, including without limitation
- * the rights to use, copy, modify, merge, publish, distribute, sublicense,
- * and/or sell copies of the Software, and to permit persons to whom the
- * Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
- * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-
-#include "DS_Utils.h"
-#include "DS_Socket.h"
-
-#include <socky.h>
-#include <assert.h>
-
-#define SPRINTF_S snprintf
-#ifdef _WIN32
-#   ifndef __MINGW32__
-#      undef SPRINTF_S
-#      define SPRINTF_S sprintf_s
-#   endif
-#endif
-
-/**
- * Copies the received data from the socket in its data buffer
- */
-static void read_socket(DS_Socket *ptr)
-{
-   /* Check arguments */
-   assert(ptr);
-
-   /* Initialize temporary buffer */
-   int read = -1;
-   char data[4096] = { 0 };
-
-   /* Read TCP socket */
-   if (ptr->type == DS_SOCKET_TCP)
-      read = recv(ptr->info.sock_in, data, sizeof(data), 0);
-
-   /* Read UDP socket */
-   if (ptr->type == DS_SOCKET_UDP)
-   {
-      read = udp_recvfrom(ptr->info.sock_in, data, sizeof(data), ptr->address, ptr->info.in_service, 0);
-   }
-
-   /* We received some data, copy it to socket's buffer */
-   if (read > 0)
-   {
-      ptr->info.buffer_size = read;
-      memset(ptr->info.buffer, 0, ptr->info.buffer_size);
-
-      int i;
-      for (i = 0; i < read; ++i)
-         ptr->info.buffer[i] = data[i];
-   }
-}
-
-/**
- * Runs the server socket loop, which uses the \c select() function
- * to copy received data into the socket's buffer only when the
- * operating system detects that the socket received some data.
- *
- * \param ptr a pointer to a \c DS_Socket structure
- */
-static void server_loop(DS_Socket *ptr)
-{
-   /* Check arguments */
-   assert(ptr);
-
-   /* Initialize variables for select */
-   int rc, fd;
-   fd_set set;
-   struct timeval tv;
-
-   /* Disable socket blocking */
-#ifndef _WIN32
-   set_socket_block(ptr->info.sock_in, 0);
-#endif
-
-   /* Run the server while the socket is valid */
-   while (ptr->info.server_init && ptr->info.sock_in > 0)
-   {
-      tv.tv_sec = 0;
-      tv.tv_usec = 5000 * 100;
-
-      FD_ZERO(&set);
-      FD_SET(ptr->info.sock_in, &set);
-
-#if defined _WIN32
-      fd = 0;
-#else
-      fd = ptr->info.sock_in + 1;
-#endif
-
-      rc = select(fd, &set, NULL, NULL, &tv);
-      if (rc > 0 && FD_ISSET(ptr->info.sock_in, &set))
-         read_socket(ptr);
-   }
-}
-
-/**
- * Initializes the given socket structure
- *
- * \param data raw pointer to a \c DS_Socket structure
- */
-static void *create_socket(void *data)
-{
-   /* Check arguments */
-   assert(data);
-   DS_Socket *ptr = (DS_Socket *)data;
-
-   /* Ensure that buffer and service strings are set to 0 */
-   memset(ptr->info.buffer, 0, sizeof(ptr->info.buffer));
-   memset(ptr->info.in_service, 0, sizeof(ptr->info.in_service));
-   memset(ptr->info.out_service, 0, sizeof(ptr->info.out_service));
-
-   /* Set service strings */
-   int len = sizeof(ptr->info.in_service);
-   SPRINTF_S(ptr->info.in_service, len, "%d", ptr->in_port);
-   SPRINTF_S(ptr->info.out_service, len, "%d", ptr->out_port);
-
-   /* Open TCP socket */
-   if (ptr->type == DS_SOCKET_TCP)
-   {
-      ptr->info.sock_in = create_server_tcp(ptr->info.in_service, SOCKY_IPv4, 0);
-      ptr->info.sock_out = create_client_tcp(ptr->address, ptr->info.out_service, SOCKY_IPv4, 0);
-   }
-
-   /* Open UDP socket */
-   else if (ptr->type == DS_SOCKET_UDP)
-   {
-      ptr->info.sock_out = create_client_udp(SOCKY_IPv4, 0);
-      ptr->info.sock_in = create_server_udp(ptr->info.in_service, SOCKY_IPv4, 0);
-   }
-
-   /* Update initialized states */
-   ptr->info.server_init = (ptr->info.sock_in > 0);
-   ptr->info.client_init = (ptr->info.sock_out > 0);
-
-   /* Start server loop */
-   server_loop(ptr);
-
-   /* Exit */
-   return NULL;
-}
-
-/**
- * Returns an empty socket for safe initialization
- */
-DS_Socket *DS_SocketEmpty(void)
-{
-   /* Initialize a new socket */
-   DS_Socket *socket = (DS_Socket *)calloc(1, sizeof(DS_Socket));
-
-   /* Fill basic data */
-   socket->in_port = 0;
-   socket->out_port = 0;
-   socket->disabled = 0;
-   socket->broadcast = 0;
-   socket->type = DS_SOCKET_UDP;
-
-   /* Fill socket info structure */
-   socket->info.sock_in = 0;
-   socket->info.sock_out = 0;
-   socket->info.buffer_size = 0;
-   socket->info.server_init = 0;
-   socket->info.client_init = 0;
-
-   /* Fill strings with 0 */
-   memset(socket->address, 0, sizeof(socket->address));
-   memset(socket->info.buffer, 0, sizeof(socket->info.buffer));
-   memset(socket->info.in_service, 0, sizeof(socket->info.in_service));
-   memset(socket->info.out_service, 0, sizeof(socket->info.out_service));
-
-   /* Return the socket data */
-   return socket;
-}
-
-/**
- * Initializes the sockets module and its event system
- */
-void Sockets_Init(void)
-{
-   sockets_init(1);
-}
-
-/**
- * Stops the event loops and closes all socket structures
- */
-void Sockets_Close(void)
-{
-   sockets_exit();
-}
-
-/**
- * Initializes and configures the given socket
- *
- * \note The socket will be initialzed in another thread to avoid blocking
- *       the main thread of the application
- */
-void DS_SocketOpen(DS_Socket *ptr)
-{
-   /* Check arguments */
-   assert(ptr);
-
-   /* Socket is disabled */
-   if (ptr->disabled)
-      return;
-
-   /* Initialize the socket in another thread */
-   pthread_t thread;
-   int error = pthread_create(&thread, NULL, &create_socket, (void *)ptr);
-
-   /* Warn the user when the socket cannot start */
-   if (error)
-   {
-      DS_String caption = DS_StrNew("LibDS");
-      DS_String message = DS_StrNew("Cannot start socket thread!");
-      DS_ShowMessageBox(&caption, &message, DS_ICON_ERROR);
-      DS_StrRmBuf(&caption);
-      DS_StrRmBuf(&message);
-   }
-
-   /* Quit if socket cannot start */
-   assert(!error);
-}
-
-/**
- * Closes the socket file descriptors of the given socket structure
- * and resets the structure's information.
- *
- * \param ptr pointer to the \c DS_Socket to close
- */
-void DS_SocketClose(DS_Socket *ptr)
-{
-   /* Check arguments */
-   assert(ptr);
-
-   /* Reset socket properties */
-   ptr->info.server_init = 0;
-   ptr->info.client_init = 0;
-
-   /* Close sockets */
-#if defined(__ANDROID__)
-   socket_close_threaded(ptr->info.sock_in);
-   socket_close_threaded(ptr->info.sock_out);
-#else
-   socket_close(ptr->info.sock_in);
-   socket_close(ptr->info.sock_out);
-#endif
-
-   /* Reset socket information structure */
-   ptr->info.sock_in = -1;
-   ptr->info.sock_out = -1;
-   ptr->info.buffer_size = 0;
-
-   /* Reset strings */
-   memset(ptr->info.buffer, 0, sizeof(ptr->info.buffer));
-   memset(ptr->info.in_service, 0, sizeof(ptr->info.in_service));
-   memset(ptr->info.out_service, 0, sizeof(ptr->info.out_service));
-}
-
-/**
- * Returns any data received by the given socket
- *
- * \param ptr pointer to a \c DS_Socket structure
- */
-DS_String DS_SocketRead(DS_Socket *ptr)
-{
-   /* Check arguments */
-   assert(ptr);
-
-   /* Socket is disabled or uninitialized */
-   if ((ptr->info.server_init == 0) || (ptr->disabled == 1))
-      return DS_StrNewLen(0);
-
-   /* Copy the current buffer and clear it */
-   if (ptr->info.buffer_size > 0)
-   {
-      DS_String buffer = DS_StrNewLen(ptr->info.buffer_size);
-
-      /* Copy buffer to string */
-      int i;
-      for (i = 0; i < (int)ptr->info.buffer_size; ++i)
-         DS_StrSetChar(&buffer, i, ptr->info.buffer[i]);
-
-      /* Clear buffer info */
-      memset(ptr->info.buffer, 0, ptr->info.buffer_size);
-      ptr->info.buffer_size = 0;
-
-      /* Return copied buffer */
-      return buffer;
-   }
-
-   return DS_StrNewLen(0);
-}
-
-/**
- * Sends the given \a data using the given socket
- *
- * \param data the data buffer to send
- * \param ptr pointer to the socket to use to send the given \a data
- *
- * \returns number of bytes written on success, -1 on failure
- */
-int DS_SocketSend(const DS_Socket *ptr, const DS_String *data)
-{
-   /* Check arguments */
-   assert(ptr);
-   assert(data);
-
-   /* Socket is disabled or uninitialized */
-   if ((ptr->info.client_init == 0) || ptr->disabled)
-      return -1;
-
-   /* Data is empty */
-   if (DS_StrEmpty(data))
-      return 0;
-
-   /* Initialize variables*/
-   int bytes_written = 0;
-   int len = DS_StrLen(data);
-   char *bytes = DS_StrToChar(data);
-
-   /* Send data using TCP */
-   if (ptr->type == DS_SOCKET_TCP)
-      bytes_written = send(ptr->info.sock_out, bytes, len, 0);
-
-   /* Send data using UDP */
-   else if (ptr->type == DS_SOCKET_UDP)
-   {
-      bytes_written = udp_sendto(ptr->info.sock_out, bytes, len, ptr->address, ptr->info.out_service, 0);
-   }
-
-   /* Delete temp. buffer */
-   DS_FREE(bytes);
-
-   /* Return error code */
-   return bytes_written;
-}
-
-/**
- * Changes the \a address of the given socket structre
- *
- * \param ptr pointer to a \c DS_Socket structure
- * \param address the new address to apply to the socket
- */
-void DS_SocketChangeAddress(DS_Socket *ptr, const char *address)
-{
-   /* Check arguments */
-   assert(ptr);
-
-   /* Abort if address is NULL */
-   if (!address)
-      return;
-
-   /* Re-assign the address */
-   memset(ptr->address, 0, sizeof(ptr->address));
-   memcpy(ptr->address, address, strlen(address));
-
-   /* Re-open the socket */
-   DS_SocketClose(ptr);
-   DS_SocketOpen(ptr);
-}
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Required for recvmmsg() and sendmmsg() */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#   define _GNU_SOURCE
+#endif
+
+#include "DS_Utils.h"
+#include "DS_Timer.h"
+#include "DS_Atomic.h"
+#include "DS_Socket.h"
+
+#include <socky.h>
+#include <assert.h>
+
+#if defined(__linux__)
+#   define USE_EPOLL
+#   define USE_RECVMMSG
+#   define USE_SENDMMSG
+#   define USE_TIMESTAMPNS
+#   include <sys/epoll.h>
+#   include <sys/eventfd.h>
+#endif
+
+/* Do not raise SIGPIPE when a TCP connection is closed by the remote host */
+#ifdef MSG_NOSIGNAL
+#   define SEND_FLAGS MSG_NOSIGNAL
+#else
+#   define SEND_FLAGS 0
+#endif
+
+#define SPRINTF_S snprintf
+#ifdef _WIN32
+#   ifndef __MINGW32__
+#      undef SPRINTF_S
+#      define SPRINTF_S sprintf_s
+#   endif
+#endif
+
+/*
+ * Re-resolve the remote address of sockets every 10 seconds, and retry
+ * failed lookups every second
+ */
+#define LOOKUP_INTERVAL ((uint64_t) 10000 * 1000000)
+#define LOOKUP_RETRY ((uint64_t) 1000 * 1000000)
+
+/*
+ * Protects the address and cached address of every socket, since they are
+ * written by the reactor thread and read by the protocol thread
+ */
+static pthread_mutex_t address_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Address lookups (e.g. mDNS names) may take seconds, so they are done by a
+ * resolver thread, which stores the results in the address cache of each
+ * socket. The reactor only reads the cached addresses.
+ */
+static int resolver_running = 0;
+static int resolver_pending = 0;
+static pthread_t resolver_thread;
+static pthread_cond_t resolver_cond = PTHREAD_COND_INITIALIZER;
+static pthread_mutex_t resolver_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Maximum number of sockets that can be registered with the reactor (each
+ * context uses four sockets)
+ */
+#define MAX_SOCKETS 256
+
+/*
+ * The reactor wakes up periodically to open sockets and refresh addresses,
+ * when there is no epoll(), it must also wake up to find new sockets
+ */
+#define POLL_TIMEOUT 100
+#define SELECT_TIMEOUT 10
+
+/*
+ * Time (in ms) that we wait for a TCP connection to be established
+ */
+#define CONNECT_TIMEOUT 2000
+
+/*
+ * Holds the information of a socket registered with the reactor
+ */
+typedef struct
+{
+   DS_Socket *socket; /* NULL if the slot is free */
+   int pending; /* 1 if the reactor must create the file descriptors */
+   int serial; /* Used to detect sockets that are closed while opening */
+} Registration;
+
+/*
+ * Reactor data, the lock protects the registrations and the file descriptors
+ * of every registered socket
+ */
+static int serial = 0;
+static int epoll_fd = -1;
+static int wake_fd = -1;
+static int reactor_running = 0;
+static pthread_t reactor_thread;
+static Registration sockets[MAX_SOCKETS];
+static unsigned int random_state = 0;
+static DS_SocketCallback ready_callback = NULL;
+static DS_SocketStateCallback state_callback = NULL;
+static pthread_mutex_t reactor_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Held while a callback runs, so that DS_SocketClose() can wait until the
+ * callbacks of the socket return (the owner may free the socket afterwards)
+ */
+static pthread_mutex_t callback_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Open sockets that use the in-process (loopback) transport, and the transport
+ * assigned to new sockets by DS_SocketEmpty()
+ */
+static DS_Socket *loopback[MAX_SOCKETS];
+static DS_SocketTransport default_transport = DS_TRANSPORT_NETWORK;
+static pthread_mutex_t loopback_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Maximum number of UDP packets that can be queued before they are flushed
+ */
+#define TX_QUEUE_SIZE 32
+
+/*
+ * Holds a copy of a queued UDP packet and its destination address, the
+ * buffers are preallocated so that queueing a packet never allocates memory
+ */
+typedef struct
+{
+   size_t len;
+   char data[DS_SOCKET_DATAGRAM_SIZE];
+   socklen_t addr_len;
+   struct sockaddr_storage addr;
+} Transmission;
+
+/*
+ * Transmit stage data, all queued UDP packets are sent through a single
+ * socket, so that one system call can send packets to every destination
+ */
+static int tx_fd = -1;
+static int tx_count = 0;
+static DS_TransmitStats tx_stats;
+static Transmission tx_queue[TX_QUEUE_SIZE];
+static pthread_mutex_t tx_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Copies the cached remote address of the given socket
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ * \param addr the structure in which to write the address
+ *
+ * \returns the length of the address, or \c 0 if it has not been resolved
+ */
+static socklen_t copy_address(const DS_Socket *ptr, struct sockaddr_storage *addr)
+{
+   /* Check arguments */
+   assert(ptr);
+   assert(addr);
+
+   /* Copy the address */
+   socklen_t len = 0;
+   pthread_mutex_lock(&address_lock);
+   if (ptr->info.peer_valid)
+   {
+      len = (socklen_t)ptr->info.peer_len;
+      memcpy(addr, ptr->info.peer, len);
+   }
+   pthread_mutex_unlock(&address_lock);
+
+   return len;
+}
+
+/**
+ * Returns the IPv4 address (in network byte order) that the datagrams
+ * received by the given socket must come from, or \c 0 if they are accepted
+ * from any host.
+ *
+ * Every context binds the same ports (with \c SO_REUSEPORT), so the system may
+ * give the datagrams of one robot to the socket of another context. Sockets
+ * only keep the datagrams sent by their cached remote address, unless they
+ * receive broadcasts or the address is not known (or is not a host address).
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ */
+static uint32_t expected_source(const DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Broadcast sockets accept data from any host */
+   if (ptr->broadcast || ptr->type != DS_SOCKET_UDP)
+      return 0;
+
+   /* Address is not resolved or is not an IPv4 address */
+   struct sockaddr_storage peer;
+   if (copy_address(ptr, &peer) < (socklen_t)sizeof(struct sockaddr_in) || peer.ss_family != AF_INET)
+      return 0;
+
+   /* Address is not a host address (e.g. 0.0.0.0 or 10.TE.AM.255) */
+   uint32_t address = ((struct sockaddr_in *)&peer)->sin_addr.s_addr;
+   if (ntohl(address) == INADDR_ANY || (ntohl(address) & 0xff) == 0xff)
+      return 0;
+
+   return address;
+}
+
+/**
+ * Returns \c 1 if a datagram received from \a addr must be kept by a socket
+ * that expects data from the \a expected address (see \c expected_source())
+ */
+static int from_source(const struct sockaddr_storage *addr, socklen_t len, uint32_t expected)
+{
+   /* Check arguments */
+   assert(addr);
+
+   /* Socket accepts data from any host */
+   if (expected == 0)
+      return 1;
+
+   /* Compare the sender address */
+   if (len >= (socklen_t)sizeof(struct sockaddr_in) && addr->ss_family == AF_INET)
+      return ((const struct sockaddr_in *)addr)->sin_addr.s_addr == expected;
+
+   return 0;
+}
+
+/**
+ * Sends every queued UDP packet using the transmit socket. When possible,
+ * all the packets are sent with a single call to \c sendmmsg()
+ *
+ * \note Call this function with the transmit lock held
+ */
+static void flush_queue(void)
+{
+   /* Nothing to send */
+   if (tx_count <= 0)
+      return;
+
+   /* Initialize variables */
+   int sent = 0;
+   int syscalls = 0;
+
+#ifdef USE_SENDMMSG
+   /* Initialize message headers */
+   struct mmsghdr msgs[TX_QUEUE_SIZE];
+   struct iovec iovecs[TX_QUEUE_SIZE];
+   memset(msgs, 0, sizeof(msgs));
+
+   /* Point each message to its packet and destination */
+   int i;
+   for (i = 0; i < tx_count; ++i)
+   {
+      iovecs[i].iov_base = tx_queue[i].data;
+      iovecs[i].iov_len = tx_queue[i].len;
+      msgs[i].msg_hdr.msg_iov = &iovecs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_name = &tx_queue[i].addr;
+      msgs[i].msg_hdr.msg_namelen = tx_queue[i].addr_len;
+   }
+
+   /* Send the packets (skip packets that cannot be sent) */
+   int offset = 0;
+   while (offset < tx_count)
+   {
+      int count = sendmmsg(tx_fd, msgs + offset, tx_count - offset, 0);
+      ++syscalls;
+
+      if (count > 0)
+      {
+         sent += count;
+         offset += count;
+      }
+
+      else
+         ++offset;
+   }
+#else
+   /* Send the packets one by one */
+   int i;
+   for (i = 0; i < tx_count; ++i)
+   {
+      Transmission *packet = &tx_queue[i];
+      int bytes = udp_sendto_addr(tx_fd, packet->data, packet->len, (struct sockaddr *)&packet->addr,
+                                  packet->addr_len, 0);
+
+      ++syscalls;
+      if (bytes >= 0)
+         ++sent;
+   }
+#endif
+
+   /* Update statistics */
+   ++tx_stats.batches;
+   tx_stats.packets += sent;
+   tx_stats.syscalls += syscalls;
+   tx_stats.errors += tx_count - sent;
+   tx_stats.last_packets = sent;
+   tx_stats.last_syscalls = syscalls;
+
+   /* Empty the queue */
+   tx_count = 0;
+}
+
+/**
+ * Returns \c 1 if the cached address of the given socket must be updated,
+ * which happens when the address is changed, when a watchdog expires, when
+ * the last lookup failed (at most once per \c LOOKUP_RETRY) or when the
+ * cached address is older than \c LOOKUP_INTERVAL
+ */
+static int address_expired(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Check if address is stale or too old */
+   pthread_mutex_lock(&address_lock);
+   uint64_t age = DS_GetMonotonicTime() - ptr->info.peer_time;
+   int expired = ptr->info.peer_stale || (!ptr->info.peer_valid && age >= LOOKUP_RETRY) || age > LOOKUP_INTERVAL;
+   pthread_mutex_unlock(&address_lock);
+
+   return expired;
+}
+
+/**
+ * Reads (and discards) a datagram from the given socket, this function is
+ * called when the receive ring of the socket is full
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ */
+static void drop_datagram(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Read the datagram into a temporary buffer */
+   char data[DS_SOCKET_DATAGRAM_SIZE];
+   int read = recv(ptr->info.sock_in, data, sizeof(data), 0);
+
+   /* Update the drop counter */
+   if (read > 0)
+      ++ptr->info.dropped;
+}
+
+#ifdef USE_TIMESTAMPNS
+/**
+ * Returns the kernel receive time of the given message (converted to the
+ * monotonic clock used by \c DS_GetMonotonicTime()), or \c 0 if the message
+ * has no timestamp
+ *
+ * \param msg the received message header
+ * \param offset difference (in ns) between the real-time and monotonic clocks
+ */
+static uint64_t kernel_time(struct msghdr *msg, int64_t offset)
+{
+   /* Check arguments */
+   assert(msg);
+
+   /* Find the timestamp control message */
+   struct cmsghdr *cmsg;
+   for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL; cmsg = CMSG_NXTHDR(msg, cmsg))
+   {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+      {
+         struct timespec ts;
+         memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+
+         int64_t real = (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+         if (real > offset)
+            return (uint64_t)(real - offset);
+      }
+   }
+
+   /* Message has no timestamp */
+   return 0;
+}
+
+/**
+ * Returns the difference between the real-time clock (used by the kernel
+ * for \c SO_TIMESTAMPNS) and the monotonic clock
+ */
+static int64_t clock_offset(void)
+{
+   struct timespec real;
+   uint64_t monotonic = DS_GetMonotonicTime();
+   clock_gettime(CLOCK_REALTIME, &real);
+   return ((int64_t)real.tv_sec * 1000000000 + real.tv_nsec) - (int64_t)monotonic;
+}
+#endif
+
+#ifdef USE_RECVMMSG
+/**
+ * Reads up to \a space datagrams with a single call to \c recvmmsg(), the
+ * datagrams are written directly into the free slots of the receive ring
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ * \param space number of free slots in the receive ring
+ */
+static void read_datagrams(DS_Socket *ptr, unsigned int space)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Initialize message headers */
+   struct mmsghdr msgs[DS_SOCKET_RING_SIZE];
+   struct iovec iovecs[DS_SOCKET_RING_SIZE];
+   struct sockaddr_storage senders[DS_SOCKET_RING_SIZE];
+   memset(msgs, 0, sizeof(msgs));
+
+#ifdef USE_TIMESTAMPNS
+   /* Initialize control buffers (for receive timestamps) */
+   char control[DS_SOCKET_RING_SIZE][CMSG_SPACE(sizeof(struct timespec))];
+#endif
+
+   /* Point each message to a free slot of the ring */
+   unsigned int i;
+   unsigned int tail = ptr->info.ring_tail;
+   for (i = 0; i < space; ++i)
+   {
+      DS_SocketDatagram *slot = &ptr->info.ring[(tail + i) % DS_SOCKET_RING_SIZE];
+      iovecs[i].iov_base = slot->data;
+      iovecs[i].iov_len = sizeof(slot->data);
+      msgs[i].msg_hdr.msg_iov = &iovecs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_name = &senders[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof(senders[i]);
+
+#ifdef USE_TIMESTAMPNS
+      if (ptr->timestamps)
+      {
+         msgs[i].msg_hdr.msg_control = control[i];
+         msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+      }
+#endif
+   }
+
+   /* Read the datagrams */
+   int count = recvmmsg(ptr->info.sock_in, msgs, space, MSG_DONTWAIT, NULL);
+   uint64_t time = DS_GetMonotonicTime();
+
+#ifdef USE_TIMESTAMPNS
+   int64_t offset = 0;
+   if (count > 0 && ptr->timestamps)
+      offset = clock_offset();
+#endif
+
+   /* Update the ring (datagrams from other hosts are discarded) */
+   int j;
+   uint32_t expected = expected_source(ptr);
+   for (j = 0; j < count; ++j)
+   {
+      if (!from_source(&senders[j], msgs[j].msg_hdr.msg_namelen, expected))
+         continue;
+
+      /* Move the datagram over the slots of the discarded datagrams */
+      DS_SocketDatagram *slot = &ptr->info.ring[tail % DS_SOCKET_RING_SIZE];
+      if (slot->data != iovecs[j].iov_base)
+         memcpy(slot->data, iovecs[j].iov_base, msgs[j].msg_len);
+
+      slot->len = msgs[j].msg_len;
+      slot->time = time;
+      slot->kernel_time = 0;
+
+      /* Use the arrival time reported by the kernel */
+#ifdef USE_TIMESTAMPNS
+      if (ptr->timestamps)
+      {
+         uint64_t kernel = kernel_time(&msgs[j].msg_hdr, offset);
+         if (kernel > 0 && kernel <= time)
+         {
+            slot->time = kernel;
+            slot->kernel_time = 1;
+         }
+      }
+#endif
+
+      ++tail;
+   }
+
+   /* Publish the datagrams to the protocol thread */
+   DS_AtomicStore(&ptr->info.ring_tail, tail);
+}
+#endif
+
+/**
+ * Returns the file descriptor that the reactor must watch for the given
+ * socket, TCP sockets receive data through their connection (client socket)
+ */
+static int watched_fd(const DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Get file descriptor */
+   if (ptr->type == DS_SOCKET_TCP)
+      return ptr->info.sock_out;
+
+   return ptr->info.sock_in;
+}
+
+/**
+ * Updates the events that the reactor watches for the given socket, the
+ * reactor stops reading a TCP socket when its stream buffer is full and
+ * waits until the socket is writable when there is data that was not sent
+ *
+ * \note Call this function with the reactor lock held
+ */
+static void update_events(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+#ifdef USE_EPOLL
+   /* Get the file descriptor */
+   int fd = watched_fd(ptr);
+   if (epoll_fd < 0 || fd <= 0)
+      return;
+
+   /* Select events */
+   struct epoll_event event;
+   memset(&event, 0, sizeof(event));
+   event.data.ptr = ptr;
+   if (!ptr->info.stream_paused)
+      event.events |= EPOLLIN;
+   if (ptr->info.pending_len > 0 || ptr->info.state == DS_SOCKET_CONNECTING)
+      event.events |= EPOLLOUT;
+
+   /* Apply events */
+   epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+#endif
+}
+
+/**
+ * Returns a pseudo-random number, used to add jitter to reconnection delays
+ */
+static unsigned int next_random(void)
+{
+   /* Seed the generator */
+   if (random_state == 0)
+      random_state = (unsigned int)DS_GetMonotonicTime() | 1;
+
+   /* Xorshift */
+   random_state ^= random_state << 13;
+   random_state ^= random_state >> 17;
+   random_state ^= random_state << 5;
+   return random_state;
+}
+
+/**
+ * Returns the time (in ns) that we must wait before reconnecting the given
+ * TCP socket. The delay grows exponentially with each failed attempt (up to
+ * \c backoff_max) and is randomly varied by \c backoff_jitter percent, so
+ * that many clients do not reconnect at the same time.
+ */
+static uint64_t backoff_delay(const DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Get exponential delay */
+   int i;
+   int delay = DS_Max(ptr->backoff_min, 1);
+   for (i = 0; i < ptr->info.attempts && delay < ptr->backoff_max; ++i)
+      delay *= 2;
+
+   delay = DS_Min(delay, DS_Max(ptr->backoff_max, 1));
+
+   /* Add jitter */
+   int range = delay * DS_Max(ptr->backoff_jitter, 0) / 100;
+   if (range > 0)
+      delay += (int)(next_random() % (unsigned int)(range * 2 + 1)) - range;
+
+   return (uint64_t)DS_Max(delay, 0) * 1000000;
+}
+
+/**
+ * Closes the connection of the given TCP socket and schedules a new
+ * connection attempt, this function is called when a connection attempt
+ * fails or when the remote host closes the connection
+ *
+ * \note Call this function with the reactor lock held
+ */
+static void close_connection(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Stop watching the connection */
+#ifdef USE_EPOLL
+   if (epoll_fd >= 0 && ptr->info.sock_out > 0)
+      epoll_ctl(epoll_fd, EPOLL_CTL_DEL, ptr->info.sock_out, NULL);
+#endif
+
+   /* Close the connection */
+   socket_close(ptr->info.sock_out);
+   ptr->info.sock_out = -1;
+   ptr->info.client_init = 0;
+   ptr->info.pending_len = 0;
+
+   /* Schedule a new connection attempt */
+   ptr->info.state = DS_SOCKET_DISCONNECTED;
+   ptr->info.retry_time = DS_GetMonotonicTime() + backoff_delay(ptr);
+   ++ptr->info.attempts;
+}
+
+/**
+ * Checks the result of the connection attempt of the given TCP socket, this
+ * function is called when the connecting socket becomes writable
+ *
+ * \note Call this function with the reactor lock held
+ */
+static void finish_connection(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Connection failed */
+   if (tcp_connect_error(ptr->info.sock_out) != 0)
+   {
+      close_connection(ptr);
+      return;
+   }
+
+   /* Connection established */
+   ptr->info.attempts = 0;
+   ptr->info.client_init = 1;
+   ptr->info.state = DS_SOCKET_CONNECTED;
+   update_events(ptr);
+}
+
+/**
+ * Appends the data received by the given TCP socket to its stream buffer.
+ *
+ * The stream buffer grows (up to \c DS_SOCKET_STREAM_MAX bytes) when it is
+ * full, but only when no frames are borrowed, since borrowed frames point to
+ * the buffer. Otherwise, the reactor stops reading the socket until the
+ * frames are released, which lets TCP flow control slow down the sender.
+ *
+ * \note Call this function with the reactor lock held
+ */
+static void read_stream(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Stream is not allocated */
+   if (!ptr->info.stream)
+      return;
+
+   /* Grow the stream buffer if it is full */
+   if (ptr->info.stream_len >= ptr->info.stream_size && ptr->info.stream_read == 0)
+   {
+      size_t size = DS_Min(ptr->info.stream_size * 2, (size_t)DS_SOCKET_STREAM_MAX);
+      char *stream = (char *)realloc(ptr->info.stream, size);
+      if (stream)
+      {
+         ptr->info.stream = stream;
+         ptr->info.stream_size = size;
+      }
+   }
+
+   /* Buffer is still full, stop reading until the frames are released */
+   if (ptr->info.stream_len >= ptr->info.stream_size)
+   {
+      ptr->info.stream_paused = 1;
+      update_events(ptr);
+      return;
+   }
+
+   /* Read the data */
+   char *buf = ptr->info.stream + ptr->info.stream_len;
+   int read = recv(ptr->info.sock_out, buf, ptr->info.stream_size - ptr->info.stream_len, 0);
+
+   /* Update stream length */
+   if (read > 0)
+      ptr->info.stream_len += read;
+
+   /* Connection was closed by the remote host, reconnect quickly */
+   else if (read == 0)
+   {
+      ptr->info.attempts = 0;
+      close_connection(ptr);
+   }
+}
+
+/**
+ * Sends the TCP data that could not be sent by \c DS_SocketSend(), this
+ * function is called when the connection becomes writable again
+ *
+ * \note Call this function with the reactor lock held
+ */
+static void write_pending(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Send as much data as possible */
+   while (ptr->info.pending_len > 0 && ptr->info.sock_out > 0)
+   {
+      int sent = send(ptr->info.sock_out, ptr->info.pending, ptr->info.pending_len, SEND_FLAGS);
+      if (sent <= 0)
+         break;
+
+      ptr->info.pending_len -= sent;
+      memmove(ptr->info.pending, ptr->info.pending + sent, ptr->info.pending_len);
+   }
+
+   /* Stop waiting for the socket to be writable */
+   update_events(ptr);
+}
+
+/**
+ * Copies the received data from the socket into its receive ring, if the
+ * ring is full, the received datagram is discarded.
+ *
+ * The ring is a single-producer/single-consumer queue: the reactor only
+ * writes into the slots between \c ring_tail and \c ring_head, and then
+ * publishes them by updating \c ring_tail. The protocol thread only reads
+ * slots before \c ring_tail and frees them by updating \c ring_head.
+ *
+ * \note Call this function with the reactor lock held
+ */
+static void read_socket(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Read TCP stream */
+   if (ptr->type == DS_SOCKET_TCP)
+   {
+      read_stream(ptr);
+      return;
+   }
+
+   /* Ring is not allocated */
+   if (!ptr->info.ring)
+      return;
+
+   /* Get free space in the ring */
+   unsigned int head = DS_AtomicLoad(&ptr->info.ring_head);
+   unsigned int space = DS_SOCKET_RING_SIZE - (ptr->info.ring_tail - head);
+
+   /* Ring is full, discard the datagram */
+   if (space == 0)
+   {
+      drop_datagram(ptr);
+      return;
+   }
+
+   /* Read all pending UDP datagrams at once */
+#ifdef USE_RECVMMSG
+   if (ptr->type == DS_SOCKET_UDP)
+   {
+      read_datagrams(ptr, space);
+      return;
+   }
+#endif
+
+   /* Initialize variables */
+   struct sockaddr_storage addr;
+   socklen_t len = sizeof(addr);
+   DS_SocketDatagram *slot = &ptr->info.ring[ptr->info.ring_tail % DS_SOCKET_RING_SIZE];
+
+   /* Read UDP socket */
+   int read = udp_recvfrom_addr(ptr->info.sock_in, slot->data, sizeof(slot->data), (struct sockaddr *)&addr, &len, 0);
+
+   /* We received some data from the expected host, add it to the ring */
+   if (read > 0 && from_source(&addr, len, expected_source(ptr)))
+   {
+      slot->len = read;
+      slot->kernel_time = 0;
+      slot->time = DS_GetMonotonicTime();
+      DS_AtomicStore(&ptr->info.ring_tail, ptr->info.ring_tail + 1);
+   }
+}
+
+/**
+ * Returns \c 1 if the received data of the given socket is stored in its
+ * receive ring (UDP sockets and every loopback socket), or \c 0 if it is
+ * stored in a stream buffer (TCP sockets)
+ */
+static int uses_ring(const DS_Socket *ptr)
+{
+   return (ptr->type == DS_SOCKET_UDP || ptr->transport == DS_TRANSPORT_LOOPBACK);
+}
+
+/**
+ * Writes the given \a data into the receive ring of the loopback socket that
+ * listens on the output port of \a ptr (there is at most one, see
+ * \c DS_SocketOpen()). This replaces the system calls used by
+ * network sockets, the data is copied once and the receiver is notified with
+ * the ready callback (from the calling thread).
+ *
+ * Senders are serialized with the loopback lock, so the ring still has a
+ * single producer and the receiver can read it without locks.
+ *
+ * \returns number of bytes delivered, or -1 if there is no receiver
+ */
+static int deliver(DS_Socket *ptr, const DS_String *data)
+{
+   /* Initialize variables */
+   int i;
+   int bytes = -1;
+   DS_Socket *receiver = NULL;
+
+   /* Find the receiver */
+   pthread_mutex_lock(&callback_lock);
+   pthread_mutex_lock(&loopback_lock);
+   for (i = 0; i < MAX_SOCKETS; ++i)
+   {
+      if (loopback[i] && loopback[i]->in_port == ptr->out_port && !loopback[i]->disabled)
+      {
+         receiver = loopback[i];
+         break;
+      }
+   }
+
+   /* Copy the data into the receiver's ring (drop it if the ring is full) */
+   if (receiver && receiver->info.ring)
+   {
+      unsigned int tail = receiver->info.ring_tail;
+      unsigned int head = DS_AtomicLoad(&receiver->info.ring_head);
+
+      if (tail - head < DS_SOCKET_RING_SIZE)
+      {
+         DS_SocketDatagram *slot = &receiver->info.ring[tail % DS_SOCKET_RING_SIZE];
+         size_t len = (size_t)DS_StrLen(data);
+         slot->len = len < DS_SOCKET_DATAGRAM_SIZE ? len : DS_SOCKET_DATAGRAM_SIZE;
+         slot->time = DS_GetMonotonicTime();
+         slot->kernel_time = 0;
+         memcpy(slot->data, data->buf, slot->len);
+         DS_AtomicStore(&receiver->info.ring_tail, tail + 1);
+      }
+
+      else
+         ++receiver->info.dropped;
+
+      bytes = (int)DS_StrLen(data);
+   }
+   pthread_mutex_unlock(&loopback_lock);
+
+   /* Notify the receiver */
+   DS_SocketCallback callback = ready_callback;
+   if (receiver && callback)
+      callback(receiver);
+   pthread_mutex_unlock(&callback_lock);
+
+   return bytes;
+}
+
+/**
+ * Wakes up the reactor thread, so that it can register new sockets
+ * immediately (only required when using epoll, since the select() fallback
+ * wakes up every few milliseconds)
+ */
+static void wake_reactor(void)
+{
+#ifdef USE_EPOLL
+   if (wake_fd >= 0)
+      eventfd_write(wake_fd, 1);
+#endif
+}
+
+/**
+ * Returns the slot index of the given socket, or \c -1 if the socket is not
+ * registered with the reactor
+ *
+ * \note Call this function with the reactor lock held
+ */
+static int find_socket(const DS_Socket *ptr)
+{
+   int i;
+   for (i = 0; i < MAX_SOCKETS; ++i)
+   {
+      if (sockets[i].socket == ptr)
+         return i;
+   }
+
+   return -1;
+}
+
+/**
+ * Returns the loopback slot index of the given socket, or \c -1 if the
+ * socket is not registered as a loopback socket
+ *
+ * \note Call this function with the loopback lock held
+ */
+static int find_loopback(const DS_Socket *ptr)
+{
+   int i;
+   for (i = 0; i < MAX_SOCKETS; ++i)
+   {
+      if (loopback[i] == ptr)
+         return i;
+   }
+
+   return -1;
+}
+
+/**
+ * Reads the data received by the given socket and sends its pending data (if
+ * it is still registered) and notifies the protocol layer that the socket
+ * has new data
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ * \param readable set to \c 1 if the socket has received data
+ * \param writable set to \c 1 if the socket can send data
+ */
+static void dispatch(DS_Socket *ptr, int readable, int writable)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Use the socket only if it was not closed in the meantime */
+   int ready = 0;
+   DS_SocketState state = DS_SOCKET_DISCONNECTED;
+   DS_SocketState old_state = DS_SOCKET_DISCONNECTED;
+   pthread_mutex_lock(&callback_lock);
+   pthread_mutex_lock(&reactor_lock);
+   if (find_socket(ptr) >= 0 && ptr->info.server_init)
+   {
+      old_state = ptr->info.state;
+
+      /* Socket is still connecting */
+      if (ptr->info.state == DS_SOCKET_CONNECTING)
+      {
+         if (readable || writable)
+            finish_connection(ptr);
+
+         readable = 0;
+         writable = 0;
+      }
+
+      if (writable)
+         write_pending(ptr);
+
+      if (readable)
+         read_socket(ptr);
+
+      if (ptr->type == DS_SOCKET_TCP)
+         ready = (ptr->info.stream_len > ptr->info.stream_read);
+      else
+         ready = (ptr->info.ring_tail != DS_AtomicLoad(&ptr->info.ring_head));
+
+      state = ptr->info.state;
+   }
+   pthread_mutex_unlock(&reactor_lock);
+
+   /* Notify connection state changes */
+   if (state != old_state && state_callback)
+      state_callback(ptr, state);
+
+   /* Deliver readiness to the protocol layer */
+   if (ready && ready_callback)
+      ready_callback(ptr);
+   pthread_mutex_unlock(&callback_lock);
+}
+
+/**
+ * Wakes the resolver thread, which updates the address cache of every
+ * socket whose address has expired
+ */
+static void request_lookups(void)
+{
+   pthread_mutex_lock(&resolver_lock);
+   resolver_pending = 1;
+   pthread_cond_signal(&resolver_cond);
+   pthread_mutex_unlock(&resolver_lock);
+}
+
+/**
+ * Resolves the remote address of the socket registered in the given
+ * \a slot (if its address has expired) and stores it in the socket's
+ * address cache.
+ *
+ * The lookup is done without holding any lock, the result is discarded if
+ * the socket is closed or its address is changed in the meantime.
+ */
+static void lookup_address(const int slot)
+{
+   /* Get the socket and copy its address */
+   int generation = 0;
+   char host[sizeof(((DS_Socket *)0)->address)];
+   char service[sizeof(((DS_Socket *)0)->info.out_service)];
+   pthread_mutex_lock(&reactor_lock);
+   int id = sockets[slot].serial;
+   DS_Socket *ptr = sockets[slot].socket;
+   if (ptr && (!ptr->info.server_init || !address_expired(ptr)))
+      ptr = NULL;
+
+   if (ptr)
+   {
+      pthread_mutex_lock(&address_lock);
+      memcpy(host, ptr->address, sizeof(host));
+      memcpy(service, ptr->info.out_service, sizeof(service));
+      generation = ptr->info.peer_generation;
+      ptr->info.peer_stale = 0;
+      pthread_mutex_unlock(&address_lock);
+   }
+   pthread_mutex_unlock(&reactor_lock);
+
+   /* Nothing to do */
+   if (!ptr)
+      return;
+
+   /* Perform the lookup */
+   socklen_t len = 0;
+   struct sockaddr_storage addr;
+   int error = udp_resolve(host, service, SOCKY_IPv4, &addr, &len);
+
+   /* Update the cache, unless the socket was closed or changed its address */
+   int updated = 0;
+   pthread_mutex_lock(&reactor_lock);
+   if (sockets[slot].socket == ptr && sockets[slot].serial == id)
+   {
+      pthread_mutex_lock(&address_lock);
+      ++ptr->info.lookups;
+      ptr->info.peer_time = DS_GetMonotonicTime();
+      if (!error && generation == ptr->info.peer_generation && len <= (socklen_t)sizeof(ptr->info.peer))
+      {
+         memcpy(ptr->info.peer, &addr, len);
+         ptr->info.peer_len = (int)len;
+         ptr->info.peer_valid = 1;
+         updated = 1;
+      }
+      pthread_mutex_unlock(&address_lock);
+   }
+   pthread_mutex_unlock(&reactor_lock);
+
+   /* Let the reactor use the new address */
+   if (updated)
+      wake_reactor();
+}
+
+/**
+ * Runs the resolver loop, which sleeps until the reactor (or a newly opened
+ * socket) requests a lookup, and then resolves every expired address
+ */
+static void *run_resolver(void *data)
+{
+   (void)data;
+
+   while (1)
+   {
+      /* Wait for a request */
+      pthread_mutex_lock(&resolver_lock);
+      while (resolver_running && !resolver_pending)
+         pthread_cond_wait(&resolver_cond, &resolver_lock);
+
+      int running = resolver_running;
+      resolver_pending = 0;
+      pthread_mutex_unlock(&resolver_lock);
+
+      /* Stop the thread */
+      if (!running)
+         break;
+
+      /* Update the expired addresses */
+      int i;
+      for (i = 0; i < MAX_SOCKETS; ++i)
+         lookup_address(i);
+   }
+
+   return NULL;
+}
+
+/**
+ * Creates the file descriptors of every socket that was opened since the
+ * last iteration of the reactor.
+ *
+ * The file descriptors are created without holding the reactor lock, since
+ * creating a TCP socket or resolving an address may take some time. If the
+ * socket is closed while we do this, the new file descriptors are discarded.
+ */
+static void open_pending_sockets(void)
+{
+   int i;
+   for (i = 0; i < MAX_SOCKETS; ++i)
+   {
+      /* Get pending socket */
+      pthread_mutex_lock(&reactor_lock);
+      int id = sockets[i].serial;
+      DS_Socket *ptr = sockets[i].pending ? sockets[i].socket : NULL;
+      sockets[i].pending = 0;
+      pthread_mutex_unlock(&reactor_lock);
+
+      /* Nothing to do */
+      if (!ptr)
+         continue;
+
+      /* Initialize variables */
+      int sock_in = -1;
+      int sock_out = -1;
+
+      /* Open TCP socket (the connection is created by the reactor) */
+      if (ptr->type == DS_SOCKET_TCP)
+         sock_in = create_server_tcp(ptr->info.in_service, SOCKY_IPv4, 0);
+
+      /* Open UDP socket */
+      else if (ptr->type == DS_SOCKET_UDP)
+      {
+         sock_out = create_client_udp(SOCKY_IPv4, 0);
+         sock_in = create_server_udp(ptr->info.in_service, SOCKY_IPv4, 0);
+      }
+
+      /* Disable socket blocking */
+#ifndef _WIN32
+      if (sock_in > 0)
+         set_socket_block(sock_in, 0);
+#endif
+
+      /* Ask the kernel to timestamp received datagrams */
+#ifdef USE_TIMESTAMPNS
+      if (sock_in > 0 && ptr->timestamps && ptr->type == DS_SOCKET_UDP)
+      {
+         int enable = 1;
+         setsockopt(sock_in, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+      }
+#endif
+
+      /* Register the file descriptors (if the socket is still open) */
+      pthread_mutex_lock(&reactor_lock);
+      int valid = (sockets[i].socket == ptr && sockets[i].serial == id);
+      if (valid)
+      {
+         ptr->info.sock_in = sock_in;
+         ptr->info.sock_out = sock_out;
+         ptr->info.server_init = (sock_in > 0);
+         ptr->info.client_init = (sock_out > 0);
+         ptr->info.state = DS_SOCKET_DISCONNECTED;
+         ptr->info.retry_time = 0;
+         ptr->info.attempts = 0;
+
+#ifdef USE_EPOLL
+         if (watched_fd(ptr) > 0)
+         {
+            struct epoll_event event;
+            memset(&event, 0, sizeof(event));
+            event.events = EPOLLIN;
+            event.data.ptr = ptr;
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, watched_fd(ptr), &event);
+         }
+#endif
+      }
+      pthread_mutex_unlock(&reactor_lock);
+
+      /* Socket was closed while we created it */
+      if (!valid)
+      {
+         socket_close(sock_in);
+         socket_close(sock_out);
+         continue;
+      }
+
+      /* Let the resolver thread obtain the remote address */
+      pthread_mutex_lock(&address_lock);
+      ptr->info.peer_stale = 1;
+      pthread_mutex_unlock(&address_lock);
+      request_lookups();
+   }
+}
+
+/**
+ * Notifies the protocol layer that the connection \a state of the socket
+ * registered in the given \a slot changed, unless the socket was closed since
+ * the reactor read its \a id. As in \c dispatch(), the callback runs with the
+ * callback lock held, so that \c DS_SocketClose() waits until it returns.
+ */
+static void notify_state(int slot, int id, DS_Socket *ptr, DS_SocketState state)
+{
+   /* Check if the socket is still registered */
+   pthread_mutex_lock(&callback_lock);
+   pthread_mutex_lock(&reactor_lock);
+   int valid = (sockets[slot].socket == ptr && sockets[slot].serial == id);
+   pthread_mutex_unlock(&reactor_lock);
+
+   /* Call the state callback */
+   if (valid && state_callback)
+      state_callback(ptr, state);
+   pthread_mutex_unlock(&callback_lock);
+}
+
+/**
+ * Starts a new connection for every TCP socket that is disconnected and
+ * whose reconnection delay has expired, and aborts connection attempts that
+ * take too long
+ *
+ * \returns the time (in ms) until the next connection attempt is due
+ */
+static int connect_sockets(void)
+{
+   int i;
+   int timeout = POLL_TIMEOUT;
+   for (i = 0; i < MAX_SOCKETS; ++i)
+   {
+      /* Get socket */
+      pthread_mutex_lock(&reactor_lock);
+      uint64_t now = DS_GetMonotonicTime();
+      int id = sockets[i].serial;
+      DS_Socket *ptr = sockets[i].socket;
+      if (ptr && (ptr->type != DS_SOCKET_TCP || !ptr->info.server_init || ptr->info.state == DS_SOCKET_CONNECTED))
+         ptr = NULL;
+
+      /* Connection attempt is not due yet */
+      if (ptr && now < ptr->info.retry_time)
+      {
+         timeout = DS_Min(timeout, (int)((ptr->info.retry_time - now) / 1000000) + 1);
+         ptr = NULL;
+      }
+
+      /* Connection attempt took too long */
+      DS_Socket *expired = NULL;
+      DS_SocketState state = DS_SOCKET_DISCONNECTED;
+      if (ptr && ptr->info.state == DS_SOCKET_CONNECTING)
+      {
+         close_connection(ptr);
+         expired = ptr;
+         ptr = NULL;
+         timeout = 0;
+      }
+      pthread_mutex_unlock(&reactor_lock);
+
+      /* Notify the protocol layer */
+      if (expired)
+         notify_state(i, id, expired, state);
+
+      /* Nothing to do */
+      if (!ptr)
+         continue;
+
+      /* Wait for the resolver thread to obtain the address */
+      struct sockaddr_storage addr;
+      socklen_t addr_len = copy_address(ptr, &addr);
+      if (addr_len == 0)
+         continue;
+
+      /* Start connecting to the cached address */
+      int sfd = create_client_tcp_async((struct sockaddr *)&addr, addr_len, 0);
+
+      /* Register the connection (if the socket is still open) */
+      pthread_mutex_lock(&reactor_lock);
+      if (sockets[i].socket == ptr && sockets[i].serial == id)
+      {
+         /* Could not start connecting */
+         if (sfd <= 0)
+         {
+            close_connection(ptr);
+            state = DS_SOCKET_DISCONNECTED;
+         }
+
+         /* Wait for the connection to be established */
+         else
+         {
+            ptr->info.sock_out = sfd;
+            ptr->info.state = DS_SOCKET_CONNECTING;
+            ptr->info.retry_time = DS_GetMonotonicTime() + (uint64_t)CONNECT_TIMEOUT * 1000000;
+            state = DS_SOCKET_CONNECTING;
+
+#ifdef USE_EPOLL
+            struct epoll_event event;
+            memset(&event, 0, sizeof(event));
+            event.events = EPOLLOUT;
+            event.data.ptr = ptr;
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sfd, &event);
+#endif
+         }
+      }
+
+      /* Socket was closed while we connected it */
+      else
+      {
+         socket_close(sfd);
+         ptr = NULL;
+      }
+      pthread_mutex_unlock(&reactor_lock);
+
+      /* Notify the protocol layer */
+      if (ptr && state == DS_SOCKET_CONNECTING)
+         notify_state(i, id, ptr, state);
+   }
+
+   return DS_Max(timeout, 0);
+}
+
+/**
+ * Wakes the resolver thread if any registered socket has a stale or too old
+ * address cache (the lookups never block the reactor)
+ */
+static void refresh_addresses(void)
+{
+   int i;
+   int expired = 0;
+   pthread_mutex_lock(&reactor_lock);
+   for (i = 0; i < MAX_SOCKETS && !expired; ++i)
+   {
+      DS_Socket *ptr = sockets[i].socket;
+      if (ptr && ptr->info.server_init)
+         expired = address_expired(ptr);
+   }
+   pthread_mutex_unlock(&reactor_lock);
+
+   if (expired)
+      request_lookups();
+}
+
+/**
+ * Waits until any of the registered sockets receives data (or until the
+ * \a timeout expires) and reads the received data
+ *
+ * \param timeout the maximum time to wait (in ms)
+ */
+static void wait_for_events(const int timeout)
+{
+#ifdef USE_EPOLL
+   /* Wait for events */
+   struct epoll_event events[MAX_SOCKETS + 1];
+   int count = epoll_wait(epoll_fd, events, MAX_SOCKETS + 1, timeout);
+
+   /* Read sockets with new data */
+   int i;
+   for (i = 0; i < count; ++i)
+   {
+      if (events[i].data.ptr)
+      {
+         int readable = (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0;
+         int writable = (events[i].events & EPOLLOUT) != 0;
+         dispatch((DS_Socket *)events[i].data.ptr, readable, writable);
+      }
+
+      else
+      {
+         eventfd_t value;
+         eventfd_read(wake_fd, &value);
+      }
+   }
+#else
+   /* Initialize variables for select */
+   int i, fd = 0;
+   fd_set read_set;
+   fd_set write_set;
+   struct timeval tv;
+
+   /* Add registered sockets to the sets */
+   FD_ZERO(&read_set);
+   FD_ZERO(&write_set);
+   pthread_mutex_lock(&reactor_lock);
+   for (i = 0; i < MAX_SOCKETS; ++i)
+   {
+      DS_Socket *ptr = sockets[i].socket;
+      if (ptr && ptr->info.server_init && watched_fd(ptr) > 0)
+      {
+         if (!ptr->info.stream_paused)
+            FD_SET(watched_fd(ptr), &read_set);
+         if (ptr->info.pending_len > 0 || ptr->info.state == DS_SOCKET_CONNECTING)
+            FD_SET(watched_fd(ptr), &write_set);
+
+         fd = DS_Max(fd, watched_fd(ptr) + 1);
+      }
+   }
+   pthread_mutex_unlock(&reactor_lock);
+
+   /* There are no sockets, select() would return immediately */
+   if (fd == 0)
+   {
+      DS_Sleep(DS_Min(timeout, SELECT_TIMEOUT));
+      return;
+   }
+
+   /* Wait for events */
+   tv.tv_sec = 0;
+   tv.tv_usec = DS_Min(timeout, SELECT_TIMEOUT) * 1000;
+#if defined _WIN32
+   fd = 0;
+#endif
+   if (select(fd, &read_set, &write_set, NULL, &tv) <= 0)
+      return;
+
+   /* Read sockets with new data */
+   for (i = 0; i < MAX_SOCKETS; ++i)
+   {
+      int readable = 0;
+      int writable = 0;
+
+      pthread_mutex_lock(&reactor_lock);
+      DS_Socket *ptr = sockets[i].socket;
+      if (ptr && watched_fd(ptr) > 0)
+      {
+         readable = FD_ISSET(watched_fd(ptr), &read_set);
+         writable = FD_ISSET(watched_fd(ptr), &write_set);
+      }
+      pthread_mutex_unlock(&reactor_lock);
+
+      if (readable || writable)
+         dispatch(ptr, readable, writable);
+   }
+#endif
+}
+
+/**
+ * Runs the reactor loop, which owns all the sockets of the library. The
+ * loop creates new sockets, refreshes their addresses, (re)connects TCP
+ * sockets and uses \c epoll()
+ * (or \c select() on other systems) to copy received data into the socket's
+ * buffer only when the operating system detects that the socket received
+ * some data.
+ */
+static void *run_reactor(void *data)
+{
+   (void)data;
+
+   while (reactor_running)
+   {
+      open_pending_sockets();
+      refresh_addresses();
+      wait_for_events(connect_sockets());
+   }
+
+   return NULL;
+}
+
+/**
+ * Returns an empty socket for safe initialization
+ */
+DS_Socket *DS_SocketEmpty(void)
+{
+   /* Initialize a new socket */
+   DS_Socket *socket = (DS_Socket *)calloc(1, sizeof(DS_Socket));
+
+   /* Fill basic data */
+   socket->in_port = 0;
+   socket->out_port = 0;
+   socket->disabled = 0;
+   socket->broadcast = 0;
+   socket->timestamps = 1;
+   socket->backoff_min = 50;
+   socket->backoff_max = 2000;
+   socket->backoff_jitter = 20;
+   socket->type = DS_SOCKET_UDP;
+   socket->transport = default_transport;
+   socket->user_data = NULL;
+
+   /* Fill socket info structure */
+   socket->info.sock_in = 0;
+   socket->info.sock_out = 0;
+   socket->info.server_init = 0;
+   socket->info.client_init = 0;
+
+   /* Reset the receive ring */
+   socket->info.ring = NULL;
+   socket->info.dropped = 0;
+   socket->info.ring_head = 0;
+   socket->info.ring_read = 0;
+   socket->info.ring_tail = 0;
+
+   /* Reset the TCP stream buffers */
+   socket->info.stream = NULL;
+   socket->info.stream_len = 0;
+   socket->info.stream_size = 0;
+   socket->info.stream_read = 0;
+   socket->info.stream_paused = 0;
+   socket->info.pending = NULL;
+   socket->info.pending_len = 0;
+
+   /* Reset the TCP connection state */
+   socket->info.attempts = 0;
+   socket->info.retry_time = 0;
+   socket->info.state = DS_SOCKET_DISCONNECTED;
+
+   /* Reset the address cache */
+   socket->info.lookups = 0;
+   socket->info.peer_len = 0;
+   socket->info.peer_time = 0;
+   socket->info.peer_valid = 0;
+   socket->info.peer_stale = 0;
+   socket->info.peer_generation = 0;
+
+   /* Fill strings with 0 */
+   memset(socket->address, 0, sizeof(socket->address));
+   memset(socket->info.in_service, 0, sizeof(socket->info.in_service));
+   memset(socket->info.out_service, 0, sizeof(socket->info.out_service));
+
+   /* Return the socket data */
+   return socket;
+}
+
+/**
+ * Initializes the sockets module and its event system
+ */
+void Sockets_Init(void)
+{
+   sockets_init(1);
+
+   /* Clear registrations */
+   memset(sockets, 0, sizeof(sockets));
+
+   /* Create the epoll instance and its wake-up descriptor */
+#ifdef USE_EPOLL
+   epoll_fd = epoll_create1(0);
+   wake_fd = eventfd(0, EFD_NONBLOCK);
+
+   struct epoll_event event;
+   memset(&event, 0, sizeof(event));
+   event.events = EPOLLIN;
+   event.data.ptr = NULL;
+   epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event);
+#endif
+
+   /* Create the transmit socket */
+   pthread_mutex_lock(&tx_lock);
+   tx_count = 0;
+   tx_fd = create_client_udp(SOCKY_IPv4, 0);
+   memset(&tx_stats, 0, sizeof(tx_stats));
+   pthread_mutex_unlock(&tx_lock);
+
+   /* Start the resolver thread */
+   pthread_mutex_lock(&resolver_lock);
+   resolver_running = 1;
+   resolver_pending = 0;
+   pthread_mutex_unlock(&resolver_lock);
+   pthread_create(&resolver_thread, NULL, &run_resolver, NULL);
+
+   /* Start the reactor thread */
+   reactor_running = 1;
+   int error = pthread_create(&reactor_thread, NULL, &run_reactor, NULL);
+
+   /* Warn the user when the reactor cannot start */
+   if (error)
+   {
+      DS_String caption = DS_StrNew("LibDS");
+      DS_String message = DS_StrNew("Cannot start socket thread!");
+      DS_ShowMessageBox(&caption, &message, DS_ICON_ERROR);
+      DS_StrRmBuf(&caption);
+      DS_StrRmBuf(&message);
+   }
+
+   /* Quit if reactor cannot start */
+   assert(!error);
+}
+
+/**
+ * Applies the given scheduling \a options to the socket thread, which is
+ * shared by all the contexts
+ *
+ * \returns the applied settings, see \c DS_SetThreadOptions()
+ */
+int Sockets_SetRealtimeOptions(const DS_RealtimeOptions *options)
+{
+   return DS_SetThreadOptions(reactor_thread, options);
+}
+
+/**
+ * Stops the event loops and closes all socket structures
+ */
+void Sockets_Close(void)
+{
+   /* Stop the reactor thread */
+   reactor_running = 0;
+   wake_reactor();
+   pthread_join(reactor_thread, NULL);
+
+   /* Stop the resolver thread (after the current lookup, if any) */
+   pthread_mutex_lock(&resolver_lock);
+   resolver_running = 0;
+   pthread_cond_signal(&resolver_cond);
+   pthread_mutex_unlock(&resolver_lock);
+   pthread_join(resolver_thread, NULL);
+
+   /* Close the epoll instance */
+#ifdef USE_EPOLL
+   pthread_mutex_lock(&reactor_lock);
+   close(epoll_fd);
+   close(wake_fd);
+   epoll_fd = -1;
+   wake_fd = -1;
+   pthread_mutex_unlock(&reactor_lock);
+#endif
+
+   /* Close the transmit socket */
+   pthread_mutex_lock(&tx_lock);
+   flush_queue();
+   socket_close(tx_fd);
+   tx_fd = -1;
+   pthread_mutex_unlock(&tx_lock);
+
+   sockets_exit();
+}
+
+/**
+ * Sets the transport used by the sockets created with \c DS_SocketEmpty().
+ *
+ * Use \c DS_TRANSPORT_LOOPBACK (before loading a protocol) to exchange the
+ * protocol packets with a test harness or another LibDS component in the same
+ * process, without the network and without system calls. The loopback
+ * sockets deliver each packet to the loopback socket whose input port is the
+ * output port of the sender.
+ *
+ * \param transport the transport to use for new sockets
+ */
+void DS_SocketSetDefaultTransport(DS_SocketTransport transport)
+{
+   default_transport = transport;
+}
+
+/**
+ * Sets the function that the reactor thread calls every time that a socket
+ * receives new data, this allows the protocol layer to react to incoming
+ * packets without polling the sockets.
+ *
+ * \note The \a callback is called from the reactor thread (or from the
+ *       sending thread when the data comes from a loopback socket)
+ *
+ * \param callback the function to call, or \c NULL to disable notifications
+ */
+void DS_SocketSetReadyCallback(DS_SocketCallback callback)
+{
+   pthread_mutex_lock(&reactor_lock);
+   ready_callback = callback;
+   pthread_mutex_unlock(&reactor_lock);
+}
+
+/**
+ * Sets the function that the reactor thread calls every time that the
+ * connection state of a TCP socket changes (e.g. when the robot reboots and
+ * its TCP server becomes available again).
+ *
+ * \note The \a callback is called from the reactor thread
+ *
+ * \param callback the function to call, or \c NULL to disable notifications
+ */
+void DS_SocketSetStateCallback(DS_SocketStateCallback callback)
+{
+   pthread_mutex_lock(&reactor_lock);
+   state_callback = callback;
+   pthread_mutex_unlock(&reactor_lock);
+}
+
+/**
+ * Initializes and configures the given socket
+ *
+ * \note The socket will be initialzed by the reactor thread to avoid
+ *       blocking the main thread of the application
+ *
+ * \note Only one loopback socket can listen on each input port, since the
+ *       senders find their receiver by port
+ */
+void DS_SocketOpen(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Socket is disabled */
+   if (ptr->disabled)
+      return;
+
+   /* Ensure that service strings are set to 0 */
+   memset(ptr->info.in_service, 0, sizeof(ptr->info.in_service));
+   memset(ptr->info.out_service, 0, sizeof(ptr->info.out_service));
+
+   /* Set service strings */
+   int len = sizeof(ptr->info.in_service);
+   SPRINTF_S(ptr->info.in_service, len, "%d", ptr->in_port);
+   SPRINTF_S(ptr->info.out_service, len, "%d", ptr->out_port);
+
+   /* Check if the socket is already open */
+   pthread_mutex_lock(&reactor_lock);
+   pthread_mutex_lock(&loopback_lock);
+   int slot = find_loopback(ptr);
+   pthread_mutex_unlock(&loopback_lock);
+   if (slot < 0)
+      slot = find_socket(ptr);
+
+   /* Register the socket with the reactor */
+   int duplicate = 0;
+   if (slot < 0)
+   {
+      /* Allocate an empty receive ring */
+      if (!ptr->info.ring && uses_ring(ptr))
+      {
+         DS_SocketDatagram *ring = (DS_SocketDatagram *)calloc(DS_SOCKET_RING_SIZE, sizeof(DS_SocketDatagram));
+         DS_AtomicStorePtr((void **)&ptr->info.ring, ring);
+      }
+
+      /* Allocate an empty stream buffer */
+      if (!ptr->info.stream && !uses_ring(ptr))
+      {
+         ptr->info.stream = (char *)calloc(DS_SOCKET_STREAM_SIZE, sizeof(char));
+         ptr->info.stream_size = DS_SOCKET_STREAM_SIZE;
+      }
+
+      ptr->info.ring_head = 0;
+      ptr->info.ring_read = 0;
+      ptr->info.ring_tail = 0;
+      ptr->info.stream_len = 0;
+      ptr->info.stream_read = 0;
+      ptr->info.stream_paused = 0;
+      ptr->info.pending_len = 0;
+
+      /* Loopback sockets are ready immediately (they have no descriptors) */
+      if (ptr->transport == DS_TRANSPORT_LOOPBACK)
+      {
+         /* Another loopback socket already listens on the input port */
+         int i;
+         pthread_mutex_lock(&loopback_lock);
+         for (i = 0; i < MAX_SOCKETS; ++i)
+         {
+            if (loopback[i] && loopback[i]->in_port == ptr->in_port)
+               duplicate = 1;
+         }
+
+         slot = duplicate ? -1 : find_loopback(NULL);
+         if (slot >= 0)
+         {
+            loopback[slot] = ptr;
+            ptr->info.server_init = 1;
+            ptr->info.client_init = 1;
+            ptr->info.state = DS_SOCKET_CONNECTED;
+         }
+         pthread_mutex_unlock(&loopback_lock);
+      }
+
+      /* Let the reactor create the network sockets */
+      else
+      {
+         slot = find_socket(NULL);
+         if (slot >= 0)
+         {
+            sockets[slot].socket = ptr;
+            sockets[slot].pending = 1;
+            sockets[slot].serial = ++serial;
+         }
+      }
+   }
+   pthread_mutex_unlock(&reactor_lock);
+
+   /* Warn the user when the socket cannot be registered */
+   if (slot < 0)
+   {
+      DS_String caption = DS_StrNew("LibDS");
+      DS_String message = DS_StrNew(duplicate ? "Loopback port is already in use!" : "Cannot register socket!");
+      DS_ShowMessageBox(&caption, &message, DS_ICON_ERROR);
+      DS_StrRmBuf(&caption);
+      DS_StrRmBuf(&message);
+   }
+
+   /* Quit if socket cannot start */
+   assert(slot >= 0);
+
+   /* Let the reactor create the socket */
+   if (ptr->transport == DS_TRANSPORT_NETWORK)
+      wake_reactor();
+}
+
+/**
+ * Closes the socket file descriptors of the given socket structure
+ * and resets the structure's information.
+ *
+ * The socket is removed from the reactor immediately, so this function does
+ * not need to wait for the reactor thread to finish. When the function returns,
+ * the ready callback is no longer running for the socket.
+ *
+ * \note The receive ring is deleted, so the socket must not be read from
+ *       another thread while it is closed, and the views obtained with
+ *       \c DS_SocketBorrow() are no longer valid
+ *
+ * \param ptr pointer to the \c DS_Socket to close
+ */
+void DS_SocketClose(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Unregister the socket */
+   pthread_mutex_lock(&reactor_lock);
+   int slot = find_socket(ptr);
+   if (slot >= 0)
+   {
+      sockets[slot].socket = NULL;
+      sockets[slot].pending = 0;
+   }
+
+   /* Unregister the loopback socket */
+   pthread_mutex_lock(&loopback_lock);
+   for (slot = 0; slot < MAX_SOCKETS; ++slot)
+   {
+      if (loopback[slot] == ptr)
+         loopback[slot] = NULL;
+   }
+   pthread_mutex_unlock(&loopback_lock);
+
+   /* Reset socket properties */
+   ptr->info.server_init = 0;
+   ptr->info.client_init = 0;
+
+   /* Invalidate the address cache */
+   pthread_mutex_lock(&address_lock);
+   ptr->info.peer_valid = 0;
+   pthread_mutex_unlock(&address_lock);
+
+   /* Remove the socket from the epoll instance */
+#ifdef USE_EPOLL
+   if (epoll_fd >= 0 && watched_fd(ptr) > 0)
+      epoll_ctl(epoll_fd, EPOLL_CTL_DEL, watched_fd(ptr), NULL);
+#endif
+
+   /* Close sockets */
+#if defined(__ANDROID__)
+   socket_close_threaded(ptr->info.sock_in);
+   socket_close_threaded(ptr->info.sock_out);
+#else
+   socket_close(ptr->info.sock_in);
+   socket_close(ptr->info.sock_out);
+#endif
+
+   /* Reset socket information structure */
+   ptr->info.sock_in = -1;
+   ptr->info.sock_out = -1;
+
+   /* Delete the receive ring (no producer can reach the socket anymore) */
+   DS_SocketDatagram *ring = ptr->info.ring;
+   DS_AtomicStorePtr((void **)&ptr->info.ring, NULL);
+   free(ring);
+   ptr->info.ring_head = 0;
+   ptr->info.ring_read = 0;
+   ptr->info.ring_tail = 0;
+
+   /* Delete the TCP stream buffers */
+   DS_FREE(ptr->info.stream);
+   DS_FREE(ptr->info.pending);
+   ptr->info.stream_len = 0;
+   ptr->info.stream_size = 0;
+   ptr->info.stream_read = 0;
+   ptr->info.stream_paused = 0;
+   ptr->info.pending_len = 0;
+
+   /* Reset the TCP connection state */
+   ptr->info.attempts = 0;
+   ptr->info.retry_time = 0;
+   ptr->info.state = DS_SOCKET_DISCONNECTED;
+
+   /* Reset strings */
+   memset(ptr->info.in_service, 0, sizeof(ptr->info.in_service));
+   memset(ptr->info.out_service, 0, sizeof(ptr->info.out_service));
+   pthread_mutex_unlock(&reactor_lock);
+
+   /* Wait for the callbacks that are running for this socket */
+   pthread_mutex_lock(&callback_lock);
+   pthread_mutex_unlock(&callback_lock);
+}
+
+/**
+ * Finds the next complete frame in the stream buffer of the given TCP socket.
+ * Each frame starts with its length (two bytes, big-endian), followed by the
+ * frame data.
+ *
+ * \note Call this function with the reactor lock held
+ *
+ * \returns \c 1 if a frame was found, \c 0 if more data is needed
+ */
+static int next_frame(DS_Socket *ptr, DS_String *view)
+{
+   /* Check arguments */
+   assert(ptr);
+   assert(view);
+
+   /* Stream is not allocated */
+   if (!ptr->info.stream)
+      return 0;
+
+   /* Find the next non-empty frame */
+   while (ptr->info.stream_len - ptr->info.stream_read >= 2)
+   {
+      /* Get frame length */
+      unsigned char *header = (unsigned char *)ptr->info.stream + ptr->info.stream_read;
+      size_t len = ((size_t)header[0] << 8) | (size_t)header[1];
+
+      /* Frame is not complete */
+      if (ptr->info.stream_len - ptr->info.stream_read < len + 2)
+         return 0;
+
+      /* Skip the frame */
+      ptr->info.stream_read += len + 2;
+
+      /* Point to the frame data */
+      if (len > 0)
+      {
+         view->buf = (char *)header + 2;
+         view->len = len;
+         return 1;
+      }
+   }
+
+   return 0;
+}
+
+/**
+ * Lets the caller access the oldest unread datagram received by the given
+ * socket without copying it. The \a view points directly to the socket's
+ * receive ring and must not be modified or freed. Call this function until
+ * it returns \c 0 to access every received datagram.
+ *
+ * The datagrams remain valid until \c DS_SocketRelease() is called, since
+ * the reactor never writes into slots that have not been released.
+ *
+ * For TCP sockets, the \a view points to the next complete frame of the
+ * stream (without its length header), partial frames are kept until the
+ * rest of their data is received.
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ * \param view the string that will point to the received data
+ * \param time if not \c NULL, set to the arrival time of the datagram (in ns,
+ *        see \c DS_GetMonotonicTime()), reported by the kernel when possible
+ *
+ * \returns \c 1 if a datagram was found, \c 0 if there is no data
+ */
+int DS_SocketBorrow(DS_Socket *ptr, DS_String *view, uint64_t *time)
+{
+   /* Check arguments */
+   assert(ptr);
+   assert(view);
+
+   /* Initialize empty view */
+   int found = 0;
+   view->buf = NULL;
+   view->len = 0;
+
+   /* Socket is disabled or uninitialized */
+   if ((ptr->info.server_init == 0) || (ptr->disabled == 1))
+      return 0;
+
+   /* Point to the next complete TCP frame */
+   if (!uses_ring(ptr))
+   {
+      pthread_mutex_lock(&reactor_lock);
+      found = next_frame(ptr, view);
+      pthread_mutex_unlock(&reactor_lock);
+
+      if (found && time)
+         *time = DS_GetMonotonicTime();
+
+      return found;
+   }
+
+   /* Get the ring and the datagrams published by the reactor (no locks) */
+   DS_SocketDatagram *ring = (DS_SocketDatagram *)DS_AtomicLoadPtr((void *const *)&ptr->info.ring);
+   unsigned int tail = DS_AtomicLoad(&ptr->info.ring_tail);
+
+   /* Point to the oldest (non-empty) unread datagram */
+   while (ring && ptr->info.ring_read != tail)
+   {
+      DS_SocketDatagram *slot = &ring[ptr->info.ring_read % DS_SOCKET_RING_SIZE];
+      ++ptr->info.ring_read;
+
+      if (slot->len > 0)
+      {
+         view->buf = slot->data;
+         view->len = slot->len;
+         found = 1;
+
+         if (time)
+            *time = slot->time;
+         break;
+      }
+   }
+
+   /* Return result */
+   return found;
+}
+
+/**
+ * Returns every datagram obtained with \c DS_SocketBorrow() to the socket's
+ * receive ring, so that the reactor can use their slots again
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ */
+void DS_SocketRelease(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Free the borrowed slots (no locks, see read_socket()) */
+   if (uses_ring(ptr))
+   {
+      DS_AtomicStore(&ptr->info.ring_head, ptr->info.ring_read);
+      return;
+   }
+
+   /* Remove the borrowed frames from the stream (keep partial frames) */
+   pthread_mutex_lock(&reactor_lock);
+   if (ptr->info.stream && ptr->info.stream_read > 0)
+   {
+      ptr->info.stream_len -= ptr->info.stream_read;
+      memmove(ptr->info.stream, ptr->info.stream + ptr->info.stream_read, ptr->info.stream_len);
+      ptr->info.stream_read = 0;
+   }
+
+   /* Resume reading the stream */
+   if (ptr->info.stream_paused)
+   {
+      ptr->info.stream_paused = 0;
+      update_events(ptr);
+   }
+   pthread_mutex_unlock(&reactor_lock);
+}
+
+/**
+ * Returns a copy of the oldest datagram received by the given socket (and
+ * removes it from the socket's receive ring). Call this function until it
+ * returns an empty string to read every received datagram.
+ *
+ * \note This function also releases any datagram obtained with
+ *       \c DS_SocketBorrow()
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ */
+DS_String DS_SocketRead(DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Initialize variables */
+   DS_String view;
+   DS_String buffer = DS_StrNewLen(0);
+
+   /* Copy the oldest datagram */
+   if (DS_SocketBorrow(ptr, &view, NULL))
+   {
+      DS_StrRmBuf(&buffer);
+      buffer = DS_StrNewLen(view.len);
+      memcpy(buffer.buf, view.buf, view.len);
+   }
+
+   /* Release the datagram */
+   DS_SocketRelease(ptr);
+
+   /* Return copied datagram */
+   return buffer;
+}
+
+/**
+ * Sends the given \a data as a single frame through the given TCP socket.
+ *
+ * The frame is sent immediately when possible, any data that the kernel does
+ * not accept (partial sends) is kept and sent by the reactor when the
+ * connection becomes writable again. If too much data is already waiting to
+ * be sent, the frame is rejected so that the caller can slow down.
+ *
+ * \returns number of bytes accepted on success, -1 on failure
+ */
+static int send_frame(DS_Socket *ptr, const DS_String *data)
+{
+   /* Check arguments */
+   assert(ptr);
+   assert(data);
+
+   /* Frame is too big */
+   size_t len = DS_StrLen(data);
+   if (len > 0xFFFF)
+      return -1;
+
+   /* Initialize variables */
+   int result = (int)len;
+   size_t frame_len = len + 2;
+   char *frame = (char *)malloc(frame_len);
+
+   /* Not enough memory for the frame */
+   if (!frame)
+      return -1;
+
+   /* Create the frame */
+   frame[0] = (char)((len >> 8) & 0xFF);
+   frame[1] = (char)(len & 0xFF);
+   memcpy(frame + 2, data->buf, len);
+
+   /* Send the frame */
+   pthread_mutex_lock(&reactor_lock);
+   if (ptr->info.sock_out <= 0 || ptr->info.pending_len + frame_len > DS_SOCKET_PENDING_MAX)
+      result = -1;
+
+   else
+   {
+      /* Send directly if there is no older data waiting to be sent */
+      size_t sent = 0;
+      if (ptr->info.pending_len == 0)
+      {
+         int bytes = send(ptr->info.sock_out, frame, frame_len, SEND_FLAGS);
+         sent = (size_t)DS_Max(bytes, 0);
+      }
+
+      /* Keep the data that was not sent */
+      if (sent < frame_len)
+      {
+         char *pending = (char *)realloc(ptr->info.pending, ptr->info.pending_len + frame_len - sent);
+         if (pending)
+         {
+            memcpy(pending + ptr->info.pending_len, frame + sent, frame_len - sent);
+            ptr->info.pending = pending;
+            ptr->info.pending_len += frame_len - sent;
+            update_events(ptr);
+         }
+      }
+   }
+   pthread_mutex_unlock(&reactor_lock);
+
+   /* Delete the frame */
+   DS_FREE(frame);
+
+   /* Return number of accepted bytes */
+   return result;
+}
+
+/**
+ * Sends the given \a data using the given socket, TCP data is sent as a
+ * length-prefixed frame (see \c DS_SocketBorrow())
+ *
+ * \param data the data buffer to send
+ * \param ptr pointer to the socket to use to send the given \a data
+ *
+ * \returns number of bytes written on success, -1 on failure
+ */
+int DS_SocketSend(DS_Socket *ptr, const DS_String *data)
+{
+   /* Check arguments */
+   assert(ptr);
+   assert(data);
+
+   /* Socket is disabled or uninitialized */
+   if ((ptr->info.client_init == 0) || ptr->disabled)
+      return -1;
+
+   /* Data is empty */
+   if (DS_StrEmpty(data))
+      return 0;
+
+   /* Copy data to the in-process receiver */
+   if (ptr->transport == DS_TRANSPORT_LOOPBACK)
+      return deliver(ptr, data);
+
+   /* Send data using TCP */
+   if (ptr->type == DS_SOCKET_TCP)
+      return send_frame(ptr, data);
+
+   /* Initialize variables*/
+   int bytes_written = 0;
+   int len = DS_StrLen(data);
+   char *bytes = DS_StrToChar(data);
+
+   /* Send data using UDP (to the cached address) */
+   if (ptr->type == DS_SOCKET_UDP)
+   {
+      struct sockaddr_storage addr;
+      socklen_t addr_len = copy_address(ptr, &addr);
+
+      /* Address has not been resolved yet */
+      if (addr_len > 0)
+         bytes_written = udp_sendto_addr(ptr->info.sock_out, bytes, len, (struct sockaddr *)&addr, addr_len, 0);
+      else
+         bytes_written = -1;
+   }
+
+   /* Delete temp. buffer */
+   DS_FREE(bytes);
+
+   /* Return error code */
+   return bytes_written;
+}
+
+/**
+ * Adds the given \a data to the transmit queue, the data will be sent when
+ * \c DS_SocketFlush() is called. This allows sending every packet that is
+ * due in a single system call.
+ *
+ * The data is copied into a preallocated queue buffer, so the caller may
+ * re-use \a data immediately. TCP data, loopback data, packets larger than
+ * \c DS_SOCKET_DATAGRAM_SIZE (and UDP data on systems where the transmit
+ * socket cannot be created) are sent immediately.
+ *
+ * \param data the data buffer to send
+ * \param ptr pointer to the socket to use to send the given \a data
+ *
+ * \returns number of bytes queued on success, -1 on failure
+ */
+int DS_SocketQueue(DS_Socket *ptr, const DS_String *data)
+{
+   /* Check arguments */
+   assert(ptr);
+   assert(data);
+
+   /* Socket is disabled or uninitialized */
+   if ((ptr->info.client_init == 0) || ptr->disabled)
+      return -1;
+
+   /* Data is empty */
+   if (DS_StrEmpty(data))
+      return 0;
+
+   /* Send TCP, loopback and oversized data directly */
+   size_t len = (size_t)DS_StrLen(data);
+   if (ptr->type != DS_SOCKET_UDP || ptr->transport == DS_TRANSPORT_LOOPBACK || tx_fd <= 0
+       || len > DS_SOCKET_DATAGRAM_SIZE)
+      return DS_SocketSend(ptr, data);
+
+   /* Get the destination address */
+   struct sockaddr_storage addr;
+   socklen_t addr_len = copy_address(ptr, &addr);
+
+   /* Address has not been resolved yet */
+   if (addr_len == 0)
+      return -1;
+
+   /* Add packet to the queue (flush it if it is full) */
+   pthread_mutex_lock(&tx_lock);
+   if (tx_count >= TX_QUEUE_SIZE)
+      flush_queue();
+
+   memcpy(tx_queue[tx_count].data, data->buf, len);
+   tx_queue[tx_count].len = len;
+   tx_queue[tx_count].addr = addr;
+   tx_queue[tx_count].addr_len = addr_len;
+   ++tx_count;
+   pthread_mutex_unlock(&tx_lock);
+
+   /* Return number of queued bytes */
+   return (int)len;
+}
+
+/**
+ * Sends every packet that was queued with \c DS_SocketQueue()
+ */
+void DS_SocketFlush(void)
+{
+   pthread_mutex_lock(&tx_lock);
+   flush_queue();
+   pthread_mutex_unlock(&tx_lock);
+}
+
+/**
+ * Copies the statistics of the transmit queue into the given structure,
+ * use them to check how many system calls each batch of packets requires
+ *
+ * \param stats pointer to a \c DS_TransmitStats structure
+ */
+void DS_SocketTransmitStats(DS_TransmitStats *stats)
+{
+   /* Check arguments */
+   assert(stats);
+
+   /* Copy statistics */
+   pthread_mutex_lock(&tx_lock);
+   *stats = tx_stats;
+   pthread_mutex_unlock(&tx_lock);
+}
+
+/**
+ * Changes the \a address of the given socket structre
+ *
+ * If the socket is an UDP socket that is already running, then the socket is
+ * not re-opened. Instead, its cached address is marked as stale and the
+ * reactor thread will perform a new lookup (this function is called when a
+ * watchdog expires, so that we can find the robot if its address changes).
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ * \param address the new address to apply to the socket
+ */
+void DS_SocketChangeAddress(DS_Socket *ptr, const char *address)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Abort if address is NULL */
+   if (!address)
+      return;
+
+   /* Re-assign the address and invalidate the cache */
+   pthread_mutex_lock(&address_lock);
+   if (strncmp(ptr->address, address, sizeof(ptr->address)) != 0)
+   {
+      memset(ptr->address, 0, sizeof(ptr->address));
+      strncpy(ptr->address, address, sizeof(ptr->address) - 1);
+
+      ptr->info.peer_valid = 0;
+      ++ptr->info.peer_generation;
+   }
+   ptr->info.peer_stale = 1;
+   pthread_mutex_unlock(&address_lock);
+
+   /* Socket is running, the reactor will update the address */
+   if (ptr->type == DS_SOCKET_UDP && ptr->info.server_init && ptr->info.client_init)
+      return;
+
+   /* Re-open the socket */
+   DS_SocketClose(ptr);
+   DS_SocketOpen(ptr);
+}
+
+/**
+ * Returns the number of datagrams that the given socket discarded because its
+ * receive ring was full (i.e. the protocol layer did not read them in time).
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ */
+unsigned long DS_SocketDropped(const DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Read the counter */
+   pthread_mutex_lock(&reactor_lock);
+   unsigned long dropped = ptr->info.dropped;
+   pthread_mutex_unlock(&reactor_lock);
+
+   return dropped;
+}
+
+/**
+ * Returns the number of address lookups performed by the given socket.
+ *
+ * Each lookup happens in the resolver thread, and lookups are only done when
+ * the socket is opened, when its address changes or is marked as stale
+ * (e.g. when a watchdog expires) and periodically to detect address changes.
+ *
+ * \param ptr pointer to a \c DS_Socket structure
+ */
+unsigned long DS_SocketLookups(const DS_Socket *ptr)
+{
+   /* Check arguments */
+   assert(ptr);
+
+   /* Read the counter */
+   pthread_mutex_lock(&address_lock);
+   unsigned long lookups = ptr->info.lookups;
+   pthread_mutex_unlock(&address_lock);
+
+   return lookups;
+}
@@ -1,172 +1,697 @@
-/*
- * The Driver Station Library (LibDS)
- * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
- *
- * Permission is hereby granted, free of charge, to any person obtaining
- * a copy of this software and associated documentation files (the "Software"),
- * to deal in the Software without restriction, including without limitation
- * the rights to use, copy, modify, merge, publish, distribute, sublicense,
- * and/or sell copies of the Software, and to permit persons to whom the
- * Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
- * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-
-#include "DS_Utils.h"
-#include "DS_Array.h"
-#include "DS_Timer.h"
-
-#include <stdio.h>
-#include <assert.h>
-
-#if defined _WIN32
-#   include <windows.h>
-#else
-#   include <unistd.h>
-#endif
-
-static DS_Array timers;
-static int running = 0;
-
-/**
- * Updates the properties of the given \a timer
- * This function is called in a separate thread for each timer that we use.
- * This is **not** the best way to implement a timer, but its effective,
- * easy to understand and efficient. Also, this implementation does not need
- * to play with the kernel/OS to compare elapsed times periodically.
- */
-static void *update_timer(void *ptr)
-{
-   assert(ptr);
-   DS_Timer *timer = (DS_Timer *)ptr;
-
-   while (running == 1)
-   {
-      if (timer->enabled && timer->time > 0 && !timer->expired)
-      {
-         timer->elapsed += timer->precision;
-
-         if (timer->elapsed >= timer->time)
-            timer->expired = 1;
-      }
-
-      DS_Sleep(timer->precision);
-   }
-
-   return NULL;
-}
-
-/**
- * Initializes the timer array, which is used to keep track of all the timers
- * used by the library. We need to do this so that we can terminate each timer
- * thread once the module is closed.
- */
-void Timers_Init(void)
-{
-   running = 1;
-   DS_ArrayInit(&timers, 10);
-}
-
-/**
- * Breaks all the timer loops and stops every thread used by this module
- */
-void Timers_Close(void)
-{
-   running = 0;
-   DS_ArrayFree(&timers);
-}
-
-/**
- * Pauses the execution state of the program/thread for the given
- * number of \a millisecs.
- *
- * We use this function to update each timer based on its precision
- */
-void DS_Sleep(const int millisecs)
-{
-#if defined _WIN32
-   Sleep(millisecs);
-#else
-   usleep(millisecs * 1000);
-#endif
-}
-
-/**
- * Resets and disables the given \a timer
- */
-void DS_TimerStop(DS_Timer *timer)
-{
-   assert(timer);
-
-   timer->enabled = 0;
-   timer->expired = 0;
-   timer->elapsed = 0;
-}
-
-/**
- * Resets and enables the given \a timer
- */
-void DS_TimerStart(DS_Timer *timer)
-{
-   assert(timer);
-
-   timer->enabled = 1;
-   timer->expired = 0;
-   timer->elapsed = 0;
-}
-
-/**
- * Resets the elapsed time and expired state of the given \a timer
- */
-void DS_TimerReset(DS_Timer *timer)
-{
-   assert(timer);
-
-   timer->expired = 0;
-   timer->elapsed = 0;
-}
-
-/**
- * Initializes the given \a timer with the given \a time and \a precision.
- * The timers are updated using a threaded while loop (that sleeps the number
- * of milliseconds specified with \a precision). As stated before, this is
- * probably not the best timer implementation out there, but its simple and
- * it works perfectly for this library.
- *
- * A word of advice, using a higher \a precision (lower value in msecs) will
- * result in increased CPU usage, this thing does not have morals and will eat
- * the whole cake if you allow it.
- */
-void DS_TimerInit(DS_Timer *timer, const int time, const int precision)
-{
-   /* Check if timer pointer is valid */
-   assert(timer);
-
-   /* Timer has already been initialized, fuck off */
-   if (timer->initialized)
-      return;
-
-   /* Configure the timer */
-   timer->enabled = 0;
-   timer->expired = 0;
-   timer->elapsed = 0;
-   timer->time = time;
-   timer->initialized = 1;
-   timer->precision = precision;
-
-   /* Configure the thread */
-   pthread_t thread;
-   int error = pthread_create(&thread, NULL, &update_timer, (void *)timer);
-
-   /* Check if thread was started */
-   assert(!error);
-}
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "DS_Utils.h"
+#include "DS_Timer.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stddef.h>
+
+#if defined _WIN32
+#   include <windows.h>
+#else
+#   include <time.h>
+#   include <unistd.h>
+#   include <sys/time.h>
+#endif
+
+/*
+ * Wait for condition variables using the monotonic clock when possible,
+ * so that changes to the system time do not affect the waits
+ */
+#if defined __linux__
+#   define USE_MONOTONIC_WAIT
+#endif
+
+/*
+ * The timers are kept in a hierarchical timing wheel: each level has 64
+ * slots, a slot of the first level covers one tick (1 ms) and a slot of the
+ * next levels covers 64 times the span of the previous level. Timers are
+ * moved to the lower levels (cascaded) as their expiry time approaches,
+ * timers that expire after the last level (~4.6 hours) are kept in the last
+ * level until they get closer.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS 4
+#define WHEEL_SPAN(level) ((uint64_t)1 << ((level) * WHEEL_BITS))
+#define WHEEL_MAX_DELTA (WHEEL_SPAN(WHEEL_LEVELS) - 1)
+#define TICK_NS 1000000 /* Duration of a tick in nanoseconds */
+#define NO_EXPIRY UINT64_MAX /* No timer is pending */
+
+/* Returns the timer that contains the given link */
+#define LINK_TIMER(ptr) ((DS_Timer *)((char *)(ptr) - offsetof(DS_Timer, link)))
+
+static int running = 0;
+static int wakeup_pending = 0;
+static pthread_t service_thread;
+static pthread_cond_t wakeup_cond;
+static pthread_mutex_t wheel_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t callback_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int pending = 0; /* Number of timers in the wheel */
+static uint64_t origin = 0; /* Monotonic time of tick zero */
+static uint64_t current = 0; /* Last tick processed by the wheel */
+static DS_TimerLink expired_list; /* Expired timers waiting for dispatch */
+static DS_TimerLink wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+
+/**
+ * Initializes the given \a list as an empty (circular) list
+ */
+static void list_init(DS_TimerLink *list)
+{
+   list->prev = list;
+   list->next = list;
+}
+
+/**
+ * Returns \c 1 if the given \a list has no timers
+ */
+static int list_empty(const DS_TimerLink *list)
+{
+   return list->next == list;
+}
+
+/**
+ * Appends the given \a link to the given \a list
+ */
+static void list_append(DS_TimerLink *list, DS_TimerLink *link)
+{
+   link->prev = list->prev;
+   link->next = list;
+   list->prev->next = link;
+   list->prev = link;
+}
+
+/**
+ * Removes the given \a link from the list that contains it (if any)
+ */
+static void list_remove(DS_TimerLink *link)
+{
+   if (link->next && link->next != link)
+   {
+      link->prev->next = link->next;
+      link->next->prev = link->prev;
+   }
+
+   list_init(link);
+}
+
+/**
+ * Moves all the timers of the \a source list to the end of the \a target list
+ */
+static void list_splice(DS_TimerLink *source, DS_TimerLink *target)
+{
+   if (list_empty(source))
+      return;
+
+   source->next->prev = target->prev;
+   source->prev->next = target;
+   target->prev->next = source->next;
+   target->prev = source->prev;
+   list_init(source);
+}
+
+/**
+ * Returns the wheel tick that corresponds to the given monotonic \a time
+ */
+static uint64_t time_to_tick(const uint64_t time)
+{
+   if (time <= origin)
+      return 0;
+
+   return (time - origin) / TICK_NS;
+}
+
+/**
+ * Puts the given \a timer in the slot that covers its expiry tick. Timers
+ * whose expiry tick has already been processed go to the current slot of
+ * the first level.
+ *
+ * \note Call this function with the wheel lock held
+ */
+static void place_timer(DS_Timer *timer)
+{
+   uint64_t expiry = timer->expiry;
+   if (expiry < current)
+      expiry = current;
+
+   /* Timers that expire after the last level wait in the last level */
+   uint64_t delta = expiry - current;
+   if (delta > WHEEL_MAX_DELTA)
+   {
+      delta = WHEEL_MAX_DELTA;
+      expiry = current + delta;
+   }
+
+   /* Find the level that covers the expiry time */
+   int level = 0;
+   while (level < WHEEL_LEVELS - 1 && delta >= WHEEL_SPAN(level + 1))
+      ++level;
+
+   /* Add the timer to its slot */
+   int slot = (int)((expiry >> (level * WHEEL_BITS)) & WHEEL_MASK);
+   list_append(&wheel[level][slot], &timer->link);
+}
+
+/**
+ * Moves the timers of the given \a slot of the given \a level to the lower
+ * levels of the wheel
+ *
+ * \returns the given \a slot, so that the caller knows if the next level
+ *          must be cascaded too
+ */
+static int cascade(const int level, const int slot)
+{
+   DS_TimerLink list;
+   list_init(&list);
+   list_splice(&wheel[level][slot], &list);
+
+   while (!list_empty(&list))
+   {
+      DS_TimerLink *link = list.next;
+      list_remove(link);
+      place_timer(LINK_TIMER(link));
+   }
+
+   return slot;
+}
+
+/**
+ * Processes the wheel ticks up to the given \a tick, expired timers are
+ * moved to the expired list
+ *
+ * \note Call this function with the wheel lock held
+ */
+static void advance_wheel(const uint64_t tick)
+{
+   while (current < tick)
+   {
+      /* Skip the ticks of an empty wheel */
+      if (pending == 0)
+      {
+         current = tick;
+         break;
+      }
+
+      /* Cascade the upper levels at the start of each of their slots */
+      ++current;
+      int slot = (int)(current & WHEEL_MASK);
+      if (slot == 0)
+      {
+         int level;
+         for (level = 1; level < WHEEL_LEVELS; ++level)
+         {
+            int index = (int)((current >> (level * WHEEL_BITS)) & WHEEL_MASK);
+            if (cascade(level, index) != 0)
+               break;
+         }
+      }
+
+      /* Move the timers of the current slot to the expired list */
+      DS_TimerLink list;
+      list_init(&list);
+      list_splice(&wheel[0][slot], &list);
+      while (!list_empty(&list))
+      {
+         DS_TimerLink *link = list.next;
+         DS_Timer *timer = LINK_TIMER(link);
+         list_remove(link);
+
+         if (timer->expiry <= current)
+         {
+            timer->expiry = NO_EXPIRY;
+            list_append(&expired_list, link);
+            --pending;
+         }
+
+         else
+            place_timer(timer);
+      }
+   }
+}
+
+/**
+ * Returns the first tick at which the wheel has work to do (an expiring
+ * timer or a cascade of the upper levels)
+ *
+ * \note Call this function with the wheel lock held
+ */
+static uint64_t next_expiry(void)
+{
+   if (pending == 0)
+      return NO_EXPIRY;
+
+   uint64_t expiry = NO_EXPIRY;
+
+   /* Find the first non-empty slot of each level */
+   int level;
+   for (level = 0; level < WHEEL_LEVELS; ++level)
+   {
+      int i;
+      uint64_t base = current >> (level * WHEEL_BITS);
+      for (i = 1; i <= WHEEL_SLOTS; ++i)
+      {
+         if (!list_empty(&wheel[level][(base + i) & WHEEL_MASK]))
+         {
+            uint64_t tick = (base + i) << (level * WHEEL_BITS);
+            expiry = DS_Min(expiry, tick);
+            break;
+         }
+      }
+   }
+
+   return expiry;
+}
+
+/**
+ * Adds the given \a timer to the wheel, so that it expires \a time
+ * milliseconds after its start time
+ *
+ * \note Call this function with the wheel lock held
+ */
+static void arm_timer(DS_Timer *timer)
+{
+   list_remove(&timer->link);
+
+   if (!running || !timer->enabled || timer->time <= 0)
+      return;
+
+   /* Skip the empty ticks before adding the first timer */
+   if (pending == 0)
+      current = DS_Max(current, time_to_tick(DS_GetMonotonicTime()));
+
+   /* Get the expiry tick (rounded up) */
+   uint64_t deadline = timer->start + (uint64_t)timer->time * TICK_NS;
+   uint64_t expiry = time_to_tick(deadline + TICK_NS - 1);
+   timer->expiry = DS_Max(current + 1, expiry);
+
+   /* Add the timer to the wheel */
+   place_timer(timer);
+   ++pending;
+
+   /* Wake the service thread, its next expiry may have changed */
+   wakeup_pending = 1;
+   pthread_cond_signal(&wakeup_cond);
+}
+
+/**
+ * Removes the given \a timer from the wheel (or from the expired list, in
+ * which the expiry of the timers is set to \c NO_EXPIRY)
+ *
+ * \note Call this function with the wheel lock held
+ */
+static void disarm_timer(DS_Timer *timer)
+{
+   DS_TimerLink *link = &timer->link;
+   if (link->next == NULL || link->next == link)
+      return;
+
+   /* Timers in the expired list are no longer counted as pending */
+   if (timer->expiry != NO_EXPIRY)
+      --pending;
+
+   list_remove(link);
+}
+
+/**
+ * Marks the timers of the expired list as expired and calls their callbacks
+ * (without holding the wheel lock, so that callbacks can restart timers)
+ */
+static void dispatch_expired(void)
+{
+   pthread_mutex_lock(&callback_lock);
+   pthread_mutex_lock(&wheel_lock);
+
+   while (!list_empty(&expired_list))
+   {
+      /* Take the first expired timer */
+      DS_TimerLink *link = expired_list.next;
+      DS_Timer *timer = LINK_TIMER(link);
+      list_remove(link);
+
+      /* Update its state */
+      timer->expired = 1;
+      timer->elapsed = (int)((DS_GetMonotonicTime() - timer->start) / TICK_NS);
+
+      /* Call its callback */
+      DS_TimerCallback callback = timer->callback;
+      void *data = timer->callback_data;
+      if (callback)
+      {
+         pthread_mutex_unlock(&wheel_lock);
+         callback(timer, data);
+         pthread_mutex_lock(&wheel_lock);
+      }
+   }
+
+   pthread_mutex_unlock(&wheel_lock);
+   pthread_mutex_unlock(&callback_lock);
+}
+
+/**
+ * This function is executed by the timer service thread, which advances the
+ * timer wheel and sleeps until the next timer expires (or until a timer is
+ * started)
+ */
+static void *run_timer_service(void *ptr)
+{
+   (void)ptr;
+
+   pthread_mutex_lock(&wheel_lock);
+   while (running)
+   {
+      /* Process the elapsed ticks */
+      advance_wheel(time_to_tick(DS_GetMonotonicTime()));
+
+      /* Notify the expired timers */
+      if (!list_empty(&expired_list))
+      {
+         pthread_mutex_unlock(&wheel_lock);
+         dispatch_expired();
+         pthread_mutex_lock(&wheel_lock);
+         continue;
+      }
+
+      /* Wait for the next expiry, or until a timer is (re)started */
+      uint64_t expiry = next_expiry();
+      if (!wakeup_pending)
+      {
+         if (expiry == NO_EXPIRY)
+            pthread_cond_wait(&wakeup_cond, &wheel_lock);
+
+         else
+            DS_CondWaitUntil(&wakeup_cond, &wheel_lock, origin + expiry * TICK_NS);
+      }
+
+      wakeup_pending = 0;
+   }
+   pthread_mutex_unlock(&wheel_lock);
+
+   return NULL;
+}
+
+/**
+ * Initializes the timer wheel and starts the timer service thread, which
+ * updates all the timers used by the library
+ */
+void Timers_Init(void)
+{
+   /* Initialize the wheel */
+   int level, slot;
+   pthread_mutex_lock(&wheel_lock);
+   for (level = 0; level < WHEEL_LEVELS; ++level)
+      for (slot = 0; slot < WHEEL_SLOTS; ++slot)
+         list_init(&wheel[level][slot]);
+   list_init(&expired_list);
+   origin = DS_GetMonotonicTime();
+   current = 0;
+   pending = 0;
+   running = 1;
+   wakeup_pending = 0;
+   pthread_mutex_unlock(&wheel_lock);
+
+   /* Initialize the wakeup condition */
+   DS_CondInit(&wakeup_cond);
+
+   /* Start the timer service */
+   int error = pthread_create(&service_thread, NULL, &run_timer_service, NULL);
+
+   /* Warn the user when the timer service cannot start */
+   if (error)
+   {
+      DS_String caption = DS_StrNew("LibDS");
+      DS_String message = DS_StrNew("Cannot start timer thread!");
+      DS_ShowMessageBox(&caption, &message, DS_ICON_ERROR);
+      DS_StrRmBuf(&caption);
+      DS_StrRmBuf(&message);
+   }
+
+   /* Quit if the timer service cannot start */
+   assert(!error);
+}
+
+/**
+ * Stops the timer service thread and removes all the timers from the wheel
+ */
+void Timers_Close(void)
+{
+   /* Stop the timer service */
+   pthread_mutex_lock(&wheel_lock);
+   running = 0;
+   pthread_cond_signal(&wakeup_cond);
+   pthread_mutex_unlock(&wheel_lock);
+   pthread_join(service_thread, NULL);
+   pthread_cond_destroy(&wakeup_cond);
+
+   /* Detach the remaining timers */
+   int level, slot;
+   pthread_mutex_lock(&wheel_lock);
+   for (level = 0; level < WHEEL_LEVELS; ++level)
+      for (slot = 0; slot < WHEEL_SLOTS; ++slot)
+         while (!list_empty(&wheel[level][slot]))
+            list_remove(wheel[level][slot].next);
+   while (!list_empty(&expired_list))
+      list_remove(expired_list.next);
+   pending = 0;
+   pthread_mutex_unlock(&wheel_lock);
+}
+
+/**
+ * Pauses the execution state of the program/thread for the given
+ * number of \a millisecs.
+ *
+ * We use this function to update each timer based on its precision
+ */
+void DS_Sleep(const int millisecs)
+{
+#if defined _WIN32
+   Sleep(millisecs);
+#else
+   usleep(millisecs * 1000);
+#endif
+}
+
+/**
+ * Returns the current value of the monotonic clock in nanoseconds.
+ *
+ * The returned value is only meaningful when compared with other values
+ * obtained with this function (e.g. to measure elapsed time), since the
+ * clock is not affected by changes to the system date & time.
+ */
+uint64_t DS_GetMonotonicTime(void)
+{
+#if defined _WIN32
+   LARGE_INTEGER counter;
+   static LARGE_INTEGER frequency;
+
+   if (frequency.QuadPart == 0)
+      QueryPerformanceFrequency(&frequency);
+
+   QueryPerformanceCounter(&counter);
+   return (uint64_t)((counter.QuadPart / frequency.QuadPart) * 1000000000
+                     + ((counter.QuadPart % frequency.QuadPart) * 1000000000) / frequency.QuadPart);
+#else
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * Initializes the given condition variable, so that it can be used with
+ * \c DS_CondWaitUntil() (the monotonic clock is used when supported)
+ */
+void DS_CondInit(pthread_cond_t *cond)
+{
+   assert(cond);
+
+   pthread_condattr_t attr;
+   pthread_condattr_init(&attr);
+#if defined USE_MONOTONIC_WAIT
+   pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+#endif
+   pthread_cond_init(cond, &attr);
+   pthread_condattr_destroy(&attr);
+}
+
+/**
+ * Waits for the given condition variable (initialized with
+ * \c DS_CondInit()) until it is signaled or until the given absolute
+ * \a deadline is reached (see \c DS_GetMonotonicTime())
+ *
+ * \returns \c ETIMEDOUT if the deadline was reached
+ */
+int DS_CondWaitUntil(pthread_cond_t *cond, pthread_mutex_t *mutex, const uint64_t deadline)
+{
+   assert(cond);
+   assert(mutex);
+
+   struct timespec ts;
+
+#if defined USE_MONOTONIC_WAIT
+   ts.tv_sec = (time_t)(deadline / 1000000000);
+   ts.tv_nsec = (long)(deadline % 1000000000);
+#else
+   uint64_t now = DS_GetMonotonicTime();
+   uint64_t delay = (deadline > now) ? deadline - now : 0;
+
+   struct timeval tv;
+   gettimeofday(&tv, NULL);
+   uint64_t time = (uint64_t)tv.tv_sec * 1000000000 + (uint64_t)tv.tv_usec * 1000 + delay;
+   ts.tv_sec = (time_t)(time / 1000000000);
+   ts.tv_nsec = (long)(time % 1000000000);
+#endif
+
+   return pthread_cond_timedwait(cond, mutex, &ts);
+}
+
+/**
+ * Returns the number of milliseconds elapsed since the given \a timer was
+ * started or reset, measured with the monotonic clock.
+ *
+ * Returns \c 0 if the timer is not enabled
+ */
+int DS_TimerElapsed(DS_Timer *timer)
+{
+   assert(timer);
+
+   pthread_mutex_lock(&wheel_lock);
+   int elapsed = 0;
+   if (timer->enabled)
+      elapsed = (int)((DS_GetMonotonicTime() - timer->start) / TICK_NS);
+   pthread_mutex_unlock(&wheel_lock);
+
+   return elapsed;
+}
+
+/**
+ * Resets and disables the given \a timer.
+ *
+ * Once this function returns, the callback of the timer is not running and
+ * will not be called until the timer is started again. A timer must be
+ * stopped before releasing its memory.
+ */
+void DS_TimerStop(DS_Timer *timer)
+{
+   assert(timer);
+
+   pthread_mutex_lock(&wheel_lock);
+   disarm_timer(timer);
+   timer->enabled = 0;
+   timer->expired = 0;
+   timer->elapsed = 0;
+   pthread_mutex_unlock(&wheel_lock);
+
+   /* Wait for a running callback (unless we are the callback) */
+   if (!pthread_equal(pthread_self(), service_thread))
+   {
+      pthread_mutex_lock(&callback_lock);
+      pthread_mutex_unlock(&callback_lock);
+   }
+}
+
+/**
+ * Resets and enables the given \a timer
+ */
+void DS_TimerStart(DS_Timer *timer)
+{
+   assert(timer);
+
+   pthread_mutex_lock(&wheel_lock);
+   disarm_timer(timer);
+   timer->enabled = 1;
+   timer->expired = 0;
+   timer->elapsed = 0;
+   timer->start = DS_GetMonotonicTime();
+   arm_timer(timer);
+   pthread_mutex_unlock(&wheel_lock);
+}
+
+/**
+ * Resets the elapsed time and expired state of the given \a timer
+ */
+void DS_TimerReset(DS_Timer *timer)
+{
+   assert(timer);
+
+   pthread_mutex_lock(&wheel_lock);
+   disarm_timer(timer);
+   timer->expired = 0;
+   timer->elapsed = 0;
+   timer->start = DS_GetMonotonicTime();
+   arm_timer(timer);
+   pthread_mutex_unlock(&wheel_lock);
+}
+
+/**
+ * Initializes the given \a timer with the given \a time (in milliseconds).
+ * The timer does not use a thread, it is updated by the timer service of
+ * the library, which only wakes up when a timer expires.
+ *
+ * The \a precision is kept for compatibility, all timers have a resolution
+ * of 1 millisecond and their elapsed time is measured with the monotonic
+ * clock (see \c DS_TimerElapsed()).
+ */
+void DS_TimerInit(DS_Timer *timer, const int time, const int precision)
+{
+   /* Check if timer pointer is valid */
+   assert(timer);
+
+   /* Timer has already been initialized, fuck off */
+   if (timer->initialized)
+      return;
+
+   /* Configure the timer */
+   timer->enabled = 0;
+   timer->expired = 0;
+   timer->elapsed = 0;
+   timer->time = time;
+   timer->initialized = 1;
+   timer->precision = precision;
+   timer->start = 0;
+   timer->expiry = 0;
+   timer->callback = NULL;
+   timer->callback_data = NULL;
+   list_init(&timer->link);
+}
+
+/**
+ * Sets the function that is called (with the given \a data) when the given
+ * \a timer expires. Pass \c NULL to remove the callback.
+ *
+ * \note The callback runs in the timer service thread, which is shared by
+ *       all the timers, so it should return quickly
+ */
+void DS_TimerSetCallback(DS_Timer *timer, DS_TimerCallback callback, void *data)
+{
+   assert(timer);
+
+   pthread_mutex_lock(&wheel_lock);
+   timer->callback = callback;
+   timer->callback_data = data;
+   pthread_mutex_unlock(&wheel_lock);
+}
@@ -1,151 +1,277 @@
-/*
- * The Driver Station Library (LibDS)
- * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
- *
- * Permission is hereby granted, free of charge, to any person obtaining
- * a copy of this software and associated documentation files (the 'Software'),
- * to deal in the Software without restriction, including without limitation
- * the rights to use, copy, modify, merge, publish, distribute, sublicense,
- * and/or sell copies of the Software, and to permit persons to whom the
- * Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
- * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
- * DEALINGS IN THE SOFTWARE.
- */
-
-#include "DS_Utils.h"
-
-#include <stdio.h>
-#include <assert.h>
-#include <stdlib.h>
-#include <string.h>
-
-#ifdef _WIN32
-#   include <windows.h>
-#   ifndef __MINGW32__
-#      pragma comment(lib, "user32.lib")
-#   endif
-#endif
-
-/**
- * Returns a single byte value that represents the ratio between the
- * given \a value and the maximum number specified.
- */
-uint8_t DS_FloatToByte(const float value, const float max)
-{
-   if (value != 0 && max != 0 && value <= max)
-   {
-      int percent = (int)((value / max) * (0xFF / 2));
-      return (uint8_t)(percent & 0xFF);
-   }
-
-   return 0;
-}
-
-/**
- * Returns a string in the format of NET.TE.AM.HOST, examples include
- *    - \c DS_GetStaticIP (10, 3794, 2) will return \c 10.37.94.2
- *    - \c DS_GetStaticIP (10, 18, 1) will return \c 10.0.18.1
- *    - and so on...
- *
- * This function is used to simplify the design and implementation of
- * different communication protocols.
- *
- * If you call this function outside the scope of the \c LibDS, remember to
- * call \c DS_FREE (STR() to avoid memory leaks.
- *
- * \param net the desired first octet of the IP
- * \param team the team number, used in second and third octets
- * \param host the host byte (or the last octet) of the IP
- */
-DS_String DS_GetStaticIP(const int net, const int team, const int host)
-{
-   int te = team / 100;
-   int am = team - (te * 100);
-   return DS_StrFormat("%d.%d.%d.%d", net, te, am, host);
-}
-
-/**
- * Shows a GUI message box if GUI options are enabled
- * during the compilation time.
- *
- * Otherwise, this function shall print to \a stderr
- */
-void DS_ShowMessageBox(const DS_String *caption, const DS_String *message, const DS_IconType icon)
-{
-   assert(caption);
-   assert(message);
-
-   /* Get native strings */
-   char *ccap = DS_StrToChar(caption);
-   char *cmsg = DS_StrToChar(message);
-
-#ifdef _WIN32
-   /* Convert strings to wstrings */
-   wchar_t *wcap = calloc(caption->len + 1, sizeof(wchar_t));
-   wchar_t *wmsg = calloc(message->len + 1, sizeof(wchar_t));
-   mbstowcs_s(NULL, wcap, caption->len + 1, ccap, caption->len);
-   mbstowcs_s(NULL, wmsg, message->len + 1, cmsg, message->len);
-
-   /* Get icon type */
-   UINT ico;
-   switch (icon)
-   {
-      case DS_ICON_ERROR:
-         ico = MB_ICONERROR;
-         break;
-      case DS_ICON_INFORMATION:
-         ico = MB_ICONINFORMATION;
-         break;
-      case DS_ICON_WARNING:
-         ico = MB_ICONWARNING;
-         break;
-      default:
-         ico = MB_ICONINFORMATION;
-         break;
-   }
-
-   /* Display message box */
-   MessageBox(NULL, wmsg, wcap, ico | MB_OK);
-
-   /* Free buffers */
-   DS_FREE(wcap);
-   DS_FREE(wmsg);
-#else
-   /* Get icon text */
-   char *cico;
-   switch (icon)
-   {
-      case DS_ICON_ERROR:
-         cico = "ERROR";
-         break;
-      case DS_ICON_INFORMATION:
-         cico = "INFORMATION";
-         break;
-      case DS_ICON_WARNING:
-         cico = "WARNING";
-         break;
-      default:
-         cico = "INFORMATION";
-         break;
-   }
-
-   /* Log message to stderr */
-   fprintf(stderr, "%s: %s\n", cico, cmsg);
-
-   /* Free icon text memory */
-   DS_FREE(cico);
-#endif
-
-   /* Free resources */
-   DS_FREE(ccap);
-   DS_FREE(cmsg);
-}
+/*
+ * The Driver Station Library (LibDS)
+ * Copyright (c) 2015-2017 Alex Spataru <alex_spataru@outlook>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the 'Software'),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Required for pthread_setaffinity_np() */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#   define _GNU_SOURCE
+#endif
+
+#include "DS_Utils.h"
+
+#include <stdio.h>
+#include <sched.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#   ifndef __MINGW32__
+#      pragma comment(lib, "user32.lib")
+#   endif
+#else
+#   include <sys/mman.h>
+#   include <sys/resource.h>
+#endif
+
+/**
+ * Changes the scheduling \a policy and \a priority of the given \a thread.
+ * If the process is not allowed to use the requested priority, the highest
+ * real-time priority allowed by its resource limits is used instead.
+ *
+ * \returns \c 1 if the scheduling policy was applied
+ */
+static int set_scheduling(pthread_t thread, const DS_SchedulingPolicy policy, const int priority)
+{
+   /* Get the native policy */
+   int native = SCHED_OTHER;
+   if (policy == DS_SCHEDULING_FIFO)
+      native = SCHED_FIFO;
+   else if (policy == DS_SCHEDULING_RR)
+      native = SCHED_RR;
+
+   /* Clamp the priority to the range of the policy */
+   struct sched_param param;
+   memset(&param, 0, sizeof(param));
+   if (native != SCHED_OTHER)
+   {
+      int min = sched_get_priority_min(native);
+      int max = sched_get_priority_max(native);
+      param.sched_priority = DS_Min(DS_Max(priority, min), max);
+   }
+
+   /* Try to apply the requested priority */
+   if (pthread_setschedparam(thread, native, &param) == 0)
+      return 1;
+
+   /* Fall back to the highest priority that we are allowed to use */
+#ifdef RLIMIT_RTPRIO
+   struct rlimit limit;
+   if (native != SCHED_OTHER && getrlimit(RLIMIT_RTPRIO, &limit) == 0)
+   {
+      if (limit.rlim_cur > 0 && limit.rlim_cur < (rlim_t)param.sched_priority)
+      {
+         param.sched_priority = (int)limit.rlim_cur;
+         return pthread_setschedparam(thread, native, &param) == 0;
+      }
+   }
+#endif
+
+   return 0;
+}
+
+/**
+ * Restricts the given \a thread to the CPUs set in the given \a mask
+ *
+ * \returns \c 1 if the affinity was applied
+ */
+static int set_affinity(pthread_t thread, const uint64_t mask)
+{
+#if defined(__linux__)
+   cpu_set_t set;
+   CPU_ZERO(&set);
+
+   /* Build the CPU set */
+   int cpu;
+   for (cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu)
+   {
+      if (mask & ((uint64_t)1 << cpu))
+         CPU_SET(cpu, &set);
+   }
+
+   return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+#else
+   (void)thread;
+   (void)mask;
+   return 0;
+#endif
+}
+
+/**
+ * Returns a single byte value that represents the ratio between the
+ * given \a value and the maximum number specified.
+ */
+uint8_t DS_FloatToByte(const float value, const float max)
+{
+   if (value != 0 && max != 0 && value <= max)
+   {
+      int percent = (int)((value / max) * (0xFF / 2));
+      return (uint8_t)(percent & 0xFF);
+   }
+
+   return 0;
+}
+
+/**
+ * Returns a string in the format of NET.TE.AM.HOST, examples include
+ *    - \c DS_GetStaticIP (10, 3794, 2) will return \c 10.37.94.2
+ *    - \c DS_GetStaticIP (10, 18, 1) will return \c 10.0.18.1
+ *    - and so on...
+ *
+ * This function is used to simplify the design and implementation of
+ * different communication protocols.
+ *
+ * If you call this function outside the scope of the \c LibDS, remember to
+ * call \c DS_FREE (STR() to avoid memory leaks.
+ *
+ * \param net the desired first octet of the IP
+ * \param team the team number, used in second and third octets
+ * \param host the host byte (or the last octet) of the IP
+ */
+DS_String DS_GetStaticIP(const int net, const int team, const int host)
+{
+   int te = team / 100;
+   int am = team - (te * 100);
+   return DS_StrFormat("%d.%d.%d.%d", net, te, am, host);
+}
+
+/**
+ * Shows a GUI message box if GUI options are enabled
+ * during the compilation time.
+ *
+ * Otherwise, this function shall print to \a stderr
+ */
+void DS_ShowMessageBox(const DS_String *caption, const DS_String *message, const DS_IconType icon)
+{
+   assert(caption);
+   assert(message);
+
+   /* Get native strings */
+   char *ccap = DS_StrToChar(caption);
+   char *cmsg = DS_StrToChar(message);
+
+#ifdef _WIN32
+   /* Convert strings to wstrings */
+   wchar_t *wcap = calloc(caption->len + 1, sizeof(wchar_t));
+   wchar_t *wmsg = calloc(message->len + 1, sizeof(wchar_t));
+   mbstowcs_s(NULL, wcap, caption->len + 1, ccap, caption->len);
+   mbstowcs_s(NULL, wmsg, message->len + 1, cmsg, message->len);
+
+   /* Get icon type */
+   UINT ico;
+   switch (icon)
+   {
+      case DS_ICON_ERROR:
+         ico = MB_ICONERROR;
+         break;
+      case DS_ICON_INFORMATION:
+         ico = MB_ICONINFORMATION;
+         break;
+      case DS_ICON_WARNING:
+         ico = MB_ICONWARNING;
+         break;
+      default:
+         ico = MB_ICONINFORMATION;
+         break;
+   }
+
+   /* Display message box */
+   MessageBox(NULL, wmsg, wcap, ico | MB_OK);
+
+   /* Free buffers */
+   DS_FREE(wcap);
+   DS_FREE(wmsg);
+#else
+   /* Get icon text */
+   char *cico;
+   switch (icon)
+   {
+      case DS_ICON_ERROR:
+         cico = "ERROR";
+         break;
+      case DS_ICON_INFORMATION:
+         cico = "INFORMATION";
+         break;
+      case DS_ICON_WARNING:
+         cico = "WARNING";
+         break;
+      default:
+         cico = "INFORMATION";
+         break;
+   }
+
+   /* Log message to stderr */
+   fprintf(stderr, "%s: %s\n", cico, cmsg);
+
+   /* Free icon text memory */
+   DS_FREE(cico);
+#endif
+
+   /* Free resources */
+   DS_FREE(ccap);
+   DS_FREE(cmsg);
+}
+
+/**
+ * Applies the scheduling policy, priority and CPU affinity of the given
+ * \a options to the given \a thread. The CPU affinity is only changed if
+ * the CPU mask of the \a options is not zero (and only on Linux).
+ *
+ * Settings that the process is not allowed to change are skipped, the
+ * thread keeps its previous settings in that case.
+ *
+ * \returns the applied settings (\c DS_REALTIME_SCHEDULING and/or
+ *          \c DS_REALTIME_AFFINITY)
+ */
+int DS_SetThreadOptions(pthread_t thread, const DS_RealtimeOptions *options)
+{
+   assert(options);
+
+   int applied = 0;
+
+   /* Change the scheduling policy */
+   if (set_scheduling(thread, options->policy, options->priority))
+      applied |= DS_REALTIME_SCHEDULING;
+
+   /* Change the CPU affinity */
+   if (options->cpu_mask && set_affinity(thread, options->cpu_mask))
+      applied |= DS_REALTIME_AFFINITY;
+
+   return applied;
+}
+
+/**
+ * Locks the current and future memory pages of the process in RAM, so that
+ * the threads of the LibDS do not stall on page faults
+ *
+ * \returns \c 1 on success, \c 0 if the memory cannot be locked (e.g. the
+ *          process lacks permissions or its \c RLIMIT_MEMLOCK is too low)
+ */
+int DS_LockMemory(void)
+{
+#ifdef _WIN32
+   return 0;
+#else
+   return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#endif
+}